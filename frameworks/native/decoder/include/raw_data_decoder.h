@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_RAW_DATA_DECODER_H
+#define HISYSEVENT_RAW_DATA_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace Encoded {
+/*
+ * Parameter decoded from the raw data of an event. The key, the string value and the items of array refer to
+ * the raw data, which should be kept until the parameter is no longer used.
+ */
+struct DecodedParam {
+    std::string_view key;
+    bool isArray = false;
+    ValueType valueType = ValueType::UNKNOWN;
+    uint8_t valueByteCnt = 0;
+
+    // value of parameter which is not an array, decided by the value type
+    uint64_t uint64Value = 0;
+    int64_t int64Value = 0;
+    double floatingValue = 0;
+    std::string_view stringValue;
+
+    // count and encoded bytes of items of array, which are decoded by RawDataDecoder::ArrayItemsDecoded
+    size_t itemCnt = 0;
+    const uint8_t* items = nullptr;
+    size_t itemsLen = 0;
+};
+
+class RawDataDecoder {
+public:
+    /*
+     * Parse the header of the event in the raw data, no data is copied except the header and the trace info.
+     * The raw data should be kept until all parameters are decoded.
+     */
+    bool Init(const uint8_t* data, size_t len);
+
+    const HiSysEventHeader& GetHeader() const;
+    std::string_view GetDomain() const;
+    std::string_view GetName() const;
+    bool HasTraceInfo() const;
+    const TraceInfo& GetTraceInfo() const;
+    size_t GetParamCount() const;
+
+    /*
+     * Decode the next parameter of the event.
+     * @return false if all parameters are decoded or the raw data is malformed, which is told by IsMalformed.
+     */
+    bool NextParam(DecodedParam& param);
+    bool IsMalformed() const;
+
+public:
+    // items of array are appended into the vector cleared, the value type of the array should match the vector
+    static bool ArrayItemsDecoded(const DecodedParam& param, std::vector<uint64_t>& items);
+    static bool ArrayItemsDecoded(const DecodedParam& param, std::vector<int64_t>& items);
+    static bool ArrayItemsDecoded(const DecodedParam& param, std::vector<double>& items);
+    static bool ArrayItemsDecoded(const DecodedParam& param, std::vector<std::string_view>& items);
+
+    static bool UnsignedVarintDecoded(const uint8_t* data, size_t len, size_t& pos, EncodeType& type,
+        uint64_t& val);
+    static bool SignedVarintDecoded(const uint8_t* data, size_t len, size_t& pos, int64_t& val);
+    static bool FloatingNumberDecoded(const uint8_t* data, size_t len, size_t& pos, double& val);
+    static bool StringValueDecoded(const uint8_t* data, size_t len, size_t& pos, std::string_view& val);
+    static bool ValueTypeDecoded(const uint8_t* data, size_t len, size_t& pos, ParamValueType& valueType);
+
+private:
+    bool ValueDecoded(DecodedParam& param);
+    bool ArrayValueDecoded(DecodedParam& param);
+    bool Malformed();
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t len_ = 0;
+    size_t pos_ = 0;
+    HiSysEventHeader header_ {};
+    TraceInfo traceInfo_ {};
+    size_t paramCnt_ = 0;
+    size_t decodedParamCnt_ = 0;
+    bool isMalformed_ = false;
+};
+} // namespace Encoded
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_RAW_DATA_DECODER_H
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "raw_data_decoder.h"
+
+#include <cstring>
+
+#include "securec.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace Encoded {
+namespace {
+constexpr unsigned int ENCODE_TYPE_OFFSET = 6;
+constexpr unsigned int TAG_BYTE_OFFSET = 5;
+constexpr uint8_t TAG_BYTE_BOUND = (1 << TAG_BYTE_OFFSET);
+constexpr uint8_t TAG_BYTE_MASK = (TAG_BYTE_BOUND - 1);
+constexpr unsigned int NON_TAG_BYTE_OFFSET = 7;
+constexpr uint8_t NON_TAG_BYTE_BOUND = (1 << NON_TAG_BYTE_OFFSET);
+constexpr uint8_t NON_TAG_BYTE_MASK = (NON_TAG_BYTE_BOUND - 1);
+constexpr unsigned int VARINT_MAX_BIT_CNT = 64;
+
+// value of fixed width which is copied from the raw data in host byte order
+template<typename T>
+bool FixedValueDecoded(const uint8_t* data, size_t len, size_t& pos, T& val)
+{
+    if (data == nullptr || pos > len || len - pos < sizeof(T) ||
+        memcpy_s(&val, sizeof(T), data + pos, sizeof(T)) != EOK) {
+        return false;
+    }
+    pos += sizeof(T);
+    return true;
+}
+
+bool IsSignedType(ValueType valueType)
+{
+    return valueType == ValueType::BOOL || valueType == ValueType::INT8 || valueType == ValueType::INT16 ||
+        valueType == ValueType::INT32 || valueType == ValueType::INT64;
+}
+
+bool IsUnsignedType(ValueType valueType)
+{
+    return valueType == ValueType::UINT8 || valueType == ValueType::UINT16 || valueType == ValueType::UINT32 ||
+        valueType == ValueType::UINT64;
+}
+
+bool IsFloatingType(ValueType valueType)
+{
+    return valueType == ValueType::FLOAT || valueType == ValueType::DOUBLE;
+}
+
+bool LengthDecoded(const uint8_t* data, size_t len, size_t& pos, uint64_t& length)
+{
+    EncodeType type = EncodeType::INVALID;
+    return RawDataDecoder::UnsignedVarintDecoded(data, len, pos, type, length) &&
+        (type == EncodeType::LENGTH_DELIMITED);
+}
+
+bool UnsignedValueDecoded(const uint8_t* data, size_t len, size_t& pos, uint64_t& val)
+{
+    EncodeType type = EncodeType::INVALID;
+    return RawDataDecoder::UnsignedVarintDecoded(data, len, pos, type, val) && (type == EncodeType::VARINT);
+}
+
+// width of item of packed array, 0 if the array is not packed or the byte count mismatches with the value type
+size_t GetPackedItemWidth(const DecodedParam& param)
+{
+    if ((param.valueType == ValueType::FLOAT && param.valueByteCnt == PACKED_FLOAT_BYTE_CNT) ||
+        (param.valueType == ValueType::DOUBLE && param.valueByteCnt == PACKED_DOUBLE_BYTE_CNT)) {
+        return static_cast<size_t>(1) << param.valueByteCnt;
+    }
+    return 0;
+}
+
+bool ItemSkipped(const uint8_t* data, size_t len, size_t& pos, ValueType valueType)
+{
+    if (IsSignedType(valueType)) {
+        int64_t val = 0;
+        return RawDataDecoder::SignedVarintDecoded(data, len, pos, val);
+    }
+    if (IsUnsignedType(valueType)) {
+        uint64_t val = 0;
+        return UnsignedValueDecoded(data, len, pos, val);
+    }
+    if (IsFloatingType(valueType)) {
+        double val = 0;
+        return RawDataDecoder::FloatingNumberDecoded(data, len, pos, val);
+    }
+    if (valueType == ValueType::STRING) {
+        std::string_view val;
+        return RawDataDecoder::StringValueDecoded(data, len, pos, val);
+    }
+    return false;
+}
+
+template<typename T, typename F>
+bool ItemsDecoded(const DecodedParam& param, std::vector<T>& items, F itemDecoded)
+{
+    items.clear();
+    if (!param.isArray) {
+        return false;
+    }
+    items.reserve(param.itemCnt);
+    size_t pos = 0;
+    for (size_t index = 0; index < param.itemCnt; ++index) {
+        T item {};
+        if (!itemDecoded(param.items, param.itemsLen, pos, item)) {
+            items.clear();
+            return false;
+        }
+        items.push_back(item);
+    }
+    return pos == param.itemsLen;
+}
+}
+
+bool RawDataDecoder::Init(const uint8_t* data, size_t len)
+{
+    *this = RawDataDecoder();
+    int32_t blockSize = 0;
+    size_t pos = 0;
+    if (!FixedValueDecoded(data, len, pos, blockSize) || blockSize < 0 || static_cast<size_t>(blockSize) > len) {
+        return Malformed();
+    }
+    data_ = data;
+    len_ = static_cast<size_t>(blockSize);
+    pos_ = pos;
+    if (!FixedValueDecoded(data_, len_, pos_, header_)) {
+        return Malformed();
+    }
+    if (header_.isTraceOpened == 1 && !FixedValueDecoded(data_, len_, pos_, traceInfo_)) {
+        return Malformed();
+    }
+    int32_t paramCnt = 0;
+    if (!FixedValueDecoded(data_, len_, pos_, paramCnt) || paramCnt < 0) {
+        return Malformed();
+    }
+    paramCnt_ = static_cast<size_t>(paramCnt);
+    return true;
+}
+
+const HiSysEventHeader& RawDataDecoder::GetHeader() const
+{
+    return header_;
+}
+
+std::string_view RawDataDecoder::GetDomain() const
+{
+    return std::string_view(header_.domain, strnlen(header_.domain, sizeof(header_.domain)));
+}
+
+std::string_view RawDataDecoder::GetName() const
+{
+    return std::string_view(header_.name, strnlen(header_.name, sizeof(header_.name)));
+}
+
+bool RawDataDecoder::HasTraceInfo() const
+{
+    return header_.isTraceOpened == 1;
+}
+
+const TraceInfo& RawDataDecoder::GetTraceInfo() const
+{
+    return traceInfo_;
+}
+
+size_t RawDataDecoder::GetParamCount() const
+{
+    return paramCnt_;
+}
+
+bool RawDataDecoder::NextParam(DecodedParam& param)
+{
+    if (isMalformed_ || data_ == nullptr || decodedParamCnt_ >= paramCnt_) {
+        return false;
+    }
+    param = DecodedParam();
+    ParamValueType valueType = { 0, 0, 0 };
+    if (!StringValueDecoded(data_, len_, pos_, param.key) || !ValueTypeDecoded(data_, len_, pos_, valueType)) {
+        return Malformed();
+    }
+    param.isArray = (valueType.isArray == 1);
+    param.valueType = static_cast<ValueType>(valueType.valueType);
+    param.valueByteCnt = valueType.valueByteCnt;
+    if (!(param.isArray ? ArrayValueDecoded(param) : ValueDecoded(param))) {
+        return Malformed();
+    }
+    ++decodedParamCnt_;
+    return true;
+}
+
+bool RawDataDecoder::IsMalformed() const
+{
+    return isMalformed_;
+}
+
+bool RawDataDecoder::ValueDecoded(DecodedParam& param)
+{
+    if (IsSignedType(param.valueType)) {
+        return SignedVarintDecoded(data_, len_, pos_, param.int64Value);
+    }
+    if (IsUnsignedType(param.valueType)) {
+        return UnsignedValueDecoded(data_, len_, pos_, param.uint64Value);
+    }
+    if (IsFloatingType(param.valueType)) {
+        return FloatingNumberDecoded(data_, len_, pos_, param.floatingValue);
+    }
+    if (param.valueType == ValueType::STRING) {
+        return StringValueDecoded(data_, len_, pos_, param.stringValue);
+    }
+    return false;
+}
+
+bool RawDataDecoder::ArrayValueDecoded(DecodedParam& param)
+{
+    uint64_t itemCnt = 0;
+    // each item is encoded as one byte at least
+    if (!LengthDecoded(data_, len_, pos_, itemCnt) || itemCnt > len_ - pos_) {
+        return false;
+    }
+    param.itemCnt = static_cast<size_t>(itemCnt);
+    param.items = data_ + pos_;
+    if (param.valueByteCnt != 0) {
+        size_t width = GetPackedItemWidth(param);
+        if (width == 0 || param.itemCnt > (len_ - pos_) / width) {
+            return false;
+        }
+        param.itemsLen = param.itemCnt * width;
+        pos_ += param.itemsLen;
+        return true;
+    }
+    size_t begin = pos_;
+    for (size_t index = 0; index < param.itemCnt; ++index) {
+        if (!ItemSkipped(data_, len_, pos_, param.valueType)) {
+            return false;
+        }
+    }
+    param.itemsLen = pos_ - begin;
+    return true;
+}
+
+bool RawDataDecoder::Malformed()
+{
+    isMalformed_ = true;
+    return false;
+}
+
+bool RawDataDecoder::ArrayItemsDecoded(const DecodedParam& param, std::vector<uint64_t>& items)
+{
+    if (!IsUnsignedType(param.valueType)) {
+        items.clear();
+        return false;
+    }
+    return ItemsDecoded(param, items, UnsignedValueDecoded);
+}
+
+bool RawDataDecoder::ArrayItemsDecoded(const DecodedParam& param, std::vector<int64_t>& items)
+{
+    if (!IsSignedType(param.valueType)) {
+        items.clear();
+        return false;
+    }
+    return ItemsDecoded(param, items, SignedVarintDecoded);
+}
+
+bool RawDataDecoder::ArrayItemsDecoded(const DecodedParam& param, std::vector<double>& items)
+{
+    if (!IsFloatingType(param.valueType)) {
+        items.clear();
+        return false;
+    }
+    size_t width = GetPackedItemWidth(param);
+    if (width == 0) {
+        return ItemsDecoded(param, items, FloatingNumberDecoded);
+    }
+    // items of packed array are fixed width values without the length of each item
+    return ItemsDecoded(param, items, [width] (const uint8_t* data, size_t len, size_t& pos, double& item) {
+        if (width == sizeof(float)) {
+            float val = 0;
+            bool ret = FixedValueDecoded(data, len, pos, val);
+            item = static_cast<double>(val);
+            return ret;
+        }
+        return FixedValueDecoded(data, len, pos, item);
+    });
+}
+
+bool RawDataDecoder::ArrayItemsDecoded(const DecodedParam& param, std::vector<std::string_view>& items)
+{
+    if (param.valueType != ValueType::STRING) {
+        items.clear();
+        return false;
+    }
+    return ItemsDecoded(param, items, StringValueDecoded);
+}
+
+bool RawDataDecoder::UnsignedVarintDecoded(const uint8_t* data, size_t len, size_t& pos, EncodeType& type,
+    uint64_t& val)
+{
+    if (data == nullptr || pos >= len) {
+        return false;
+    }
+    uint8_t byte = data[pos++];
+    type = static_cast<EncodeType>(byte >> ENCODE_TYPE_OFFSET);
+    val = byte & TAG_BYTE_MASK;
+    bool hasNext = (byte & TAG_BYTE_BOUND) != 0;
+    for (unsigned int offset = TAG_BYTE_OFFSET; hasNext; offset += NON_TAG_BYTE_OFFSET) {
+        if (pos >= len || offset >= VARINT_MAX_BIT_CNT) {
+            return false;
+        }
+        byte = data[pos++];
+        val |= static_cast<uint64_t>(byte & NON_TAG_BYTE_MASK) << offset;
+        hasNext = (byte & NON_TAG_BYTE_BOUND) != 0;
+    }
+    return true;
+}
+
+bool RawDataDecoder::SignedVarintDecoded(const uint8_t* data, size_t len, size_t& pos, int64_t& val)
+{
+    uint64_t uval = 0;
+    if (!UnsignedValueDecoded(data, len, pos, uval)) {
+        return false;
+    }
+    // zigzag decoding
+    val = static_cast<int64_t>((uval >> 1) ^ (~(uval & 1) + 1));
+    return true;
+}
+
+bool RawDataDecoder::FloatingNumberDecoded(const uint8_t* data, size_t len, size_t& pos, double& val)
+{
+    uint64_t size = 0;
+    if (!LengthDecoded(data, len, pos, size)) {
+        return false;
+    }
+    if (size == sizeof(float)) {
+        float fval = 0;
+        bool ret = FixedValueDecoded(data, len, pos, fval);
+        val = static_cast<double>(fval);
+        return ret;
+    }
+    return (size == sizeof(double)) && FixedValueDecoded(data, len, pos, val);
+}
+
+bool RawDataDecoder::StringValueDecoded(const uint8_t* data, size_t len, size_t& pos, std::string_view& val)
+{
+    uint64_t size = 0;
+    if (!LengthDecoded(data, len, pos, size) || size > len - pos) {
+        return false;
+    }
+    val = std::string_view(reinterpret_cast<const char*>(data + pos), static_cast<size_t>(size));
+    pos += static_cast<size_t>(size);
+    return true;
+}
+
+bool RawDataDecoder::ValueTypeDecoded(const uint8_t* data, size_t len, size_t& pos, ParamValueType& valueType)
+{
+    return FixedValueDecoded(data, len, pos, valueType);
+}
+} // namespace Encoded
+} // namespace HiviewDFX
+} // namespace OHOS
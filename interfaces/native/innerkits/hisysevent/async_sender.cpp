@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "async_sender.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+
+#include "def.h"
+#include "event_queue.h"
+#include "event_rule_table.h"
+#include "event_socket_factory.h"
+#include "hilog/log.h"
+#include "transport.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_ASYNC_SENDER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char SENDER_THREAD_NAME[] = "hisysevent_send";
+constexpr long MS_PER_SECOND = 1000;
+constexpr long NS_PER_MS = 1000000;
+constexpr long NS_PER_SECOND = 1000000000;
+
+struct Lane {
+    explicit Lane(uint32_t depth) : queue(depth) {}
+
+    EventQueue queue;
+    sem_t wakeUpSem;
+    sem_t roomMadeSem; // posted by the sender for the writers blocked by the full queue
+    std::atomic<uint32_t> blockedCnt { 0 };
+    std::atomic<AsyncDropPolicy> dropPolicy { AsyncDropPolicy::DROP_NEWEST };
+    std::atomic<bool> isSenderStarted { false };
+    std::atomic<bool> isSenderSleeping { false };
+    std::atomic<uint64_t> sentCnt { 0 };
+    std::atomic<uint64_t> failedCnt { 0 };
+    std::atomic<uint64_t> droppedCnt { 0 };
+    std::atomic<uint32_t> highWaterMark { 0 };
+};
+
+std::atomic<bool> g_isAsyncEnabled { false };
+std::mutex g_initMutex;
+// lanes and rules are never released, the sender threads may be still running while the process exits
+std::atomic<Lane*> g_lanes[MAX_PRIORITY_LANE_CNT] = {};
+std::atomic<uint32_t> g_laneCnt { 0 };
+std::atomic<const EventRuleTable*> g_laneRules { nullptr };
+std::list<std::unique_ptr<EventRuleTable>> g_loadedLaneRules;
+
+void OnChildForked()
+{
+    // the sender threads do not exist in the child process, and the queued events will be sent by the parent
+    for (auto& item : g_lanes) {
+        auto lane = item.load(std::memory_order_acquire);
+        if (lane == nullptr) {
+            continue;
+        }
+        lane->queue.Reset();
+        (void)sem_init(&lane->wakeUpSem, 0, 0);
+        (void)sem_init(&lane->roomMadeSem, 0, 0);
+        lane->blockedCnt.store(0, std::memory_order_relaxed);
+        lane->isSenderSleeping.store(false, std::memory_order_relaxed);
+        lane->isSenderStarted.store(false, std::memory_order_relaxed);
+    }
+}
+
+void WakeUpSender(Lane& lane)
+{
+    if (lane.isSenderSleeping.exchange(false)) {
+        (void)sem_post(&lane.wakeUpSem);
+    }
+}
+
+void NotifyRoomMade(Lane& lane)
+{
+    // pairs with the fence of the blocked writer, so that either the writer finds the room or it is woken up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (lane.blockedCnt.load(std::memory_order_relaxed) > 0) {
+        (void)sem_post(&lane.roomMadeSem);
+    }
+}
+
+bool WaitForRoom(Lane& lane, const struct timespec& deadline)
+{
+    WakeUpSender(lane);
+    int ret = 0;
+    while ((ret = sem_timedwait(&lane.roomMadeSem, &deadline)) != 0 && errno == EINTR) {}
+    return ret == 0;
+}
+
+struct timespec GetBlockDeadline()
+{
+    struct timespec deadline = { 0, 0 };
+    (void)clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += static_cast<time_t>(MAX_ASYNC_BLOCK_TIME / MS_PER_SECOND);
+    deadline.tv_nsec += static_cast<long>(MAX_ASYNC_BLOCK_TIME % MS_PER_SECOND) * NS_PER_MS;
+    if (deadline.tv_nsec >= NS_PER_SECOND) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= NS_PER_SECOND;
+    }
+    return deadline;
+}
+
+void* SendEvents(void* arg)
+{
+    (void)pthread_setname_np(pthread_self(), SENDER_THREAD_NAME);
+    auto& lane = *static_cast<Lane*>(arg);
+    auto sendEvent = [&lane] (RawData& rawData, const EventRoute& route) {
+        // route of the event has been decided while it was submitted
+        if (Transport::GetInstance().SendData(rawData, route) == SUCCESS) {
+            lane.sentCnt.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            lane.failedCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    while (true) {
+        if (lane.queue.Pop(sendEvent)) {
+            NotifyRoomMade(lane);
+            continue;
+        }
+        // events staged in batch mode should not be kept while the queue is idle
+        (void)Transport::GetInstance().Flush();
+        lane.isSenderSleeping.store(true);
+        if (lane.queue.Pop(sendEvent)) {
+            NotifyRoomMade(lane);
+        } else {
+            while (sem_wait(&lane.wakeUpSem) != 0 && errno == EINTR) {}
+        }
+        lane.isSenderSleeping.store(false);
+    }
+    return nullptr;
+}
+
+bool StartSender(Lane& lane)
+{
+    if (lane.isSenderStarted.load(std::memory_order_acquire)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(g_initMutex);
+    if (lane.isSenderStarted.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    pthread_t tid;
+    if (pthread_create(&tid, nullptr, SendEvents, &lane) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to create thread to send events, errno=%{public}d", errno);
+        return false;
+    }
+    (void)pthread_detach(tid);
+    lane.isSenderStarted.store(true, std::memory_order_release);
+    return true;
+}
+
+// should be called with g_initMutex locked
+bool LanesConfigured(const std::vector<PriorityLaneConfig>& configs, std::unique_ptr<EventRuleTable> rules)
+{
+    static bool isForkHandlerRegistered = false;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        if (g_lanes[i].load(std::memory_order_relaxed) != nullptr) {
+            continue;
+        }
+        auto lane = new(std::nothrow) Lane(std::clamp(configs[i].queueDepth, 1U, MAX_ASYNC_QUEUE_DEPTH));
+        if (lane == nullptr) {
+            HILOG_ERROR(LOG_CORE, "failed to create lane %{public}zu of async mode", i);
+            return false;
+        }
+        (void)sem_init(&lane->wakeUpSem, 0, 0);
+        (void)sem_init(&lane->roomMadeSem, 0, 0);
+        g_lanes[i].store(lane, std::memory_order_release);
+    }
+    if (!isForkHandlerRegistered) {
+        (void)pthread_atfork(nullptr, nullptr, OnChildForked);
+        isForkHandlerRegistered = true;
+    }
+    for (size_t i = 0; i < configs.size(); ++i) {
+        g_lanes[i].load(std::memory_order_relaxed)->dropPolicy.store(configs[i].policy, std::memory_order_relaxed);
+    }
+    g_laneRules.store(rules.get(), std::memory_order_release);
+    if (rules != nullptr) {
+        g_loadedLaneRules.push_back(std::move(rules));
+    }
+    g_laneCnt.store(static_cast<uint32_t>(configs.size()), std::memory_order_release);
+    return true;
+}
+
+Lane& SelectLane(RawData& rawData, uint32_t laneCnt)
+{
+    uint32_t index = laneCnt - 1;
+    if (auto rules = g_laneRules.load(std::memory_order_acquire); laneCnt > 1 && rules != nullptr) {
+        // lane of the rule may be out of range while the lanes are being reduced
+        if (auto rule = rules->Find(rawData); rule != nullptr) {
+            index = std::min<uint32_t>(rule->value, index);
+        }
+    }
+    return *g_lanes[index].load(std::memory_order_acquire);
+}
+
+void UpdateHighWaterMark(Lane& lane)
+{
+    auto size = lane.queue.GetSize();
+    auto mark = lane.highWaterMark.load(std::memory_order_relaxed);
+    while (size > mark && !lane.highWaterMark.compare_exchange_weak(mark, size, std::memory_order_relaxed)) {}
+}
+}
+
+void AsyncSender::SetEnabled(bool enabled, uint32_t queueDepth, AsyncDropPolicy policy)
+{
+    std::lock_guard<std::mutex> lock(g_initMutex);
+    if (enabled && !LanesConfigured({ PriorityLaneConfig { queueDepth, policy, {} } }, nullptr)) {
+        return;
+    }
+    g_isAsyncEnabled.store(enabled, std::memory_order_release);
+}
+
+bool AsyncSender::IsEnabled()
+{
+    return g_isAsyncEnabled.load(std::memory_order_acquire);
+}
+
+int AsyncSender::Submit(RawData& rawData, const EventRoute& route)
+{
+    if (rawData.IsEmpty()) {
+        HILOG_WARN(LOG_CORE, "try to submit a empty data.");
+        return ERR_EMPTY_EVENT;
+    }
+    if (rawData.GetDataLength() > MAX_DATA_SIZE) {
+        return ERR_OVER_SIZE;
+    }
+    uint32_t laneCnt = g_laneCnt.load(std::memory_order_acquire);
+    if (laneCnt == 0) {
+        return Transport::GetInstance().SendData(rawData, route);
+    }
+    auto& lane = SelectLane(rawData, laneCnt);
+    if (!StartSender(lane)) {
+        return Transport::GetInstance().SendData(rawData, route);
+    }
+    auto policy = lane.dropPolicy.load(std::memory_order_relaxed);
+    EventQueue::PushResult ret;
+    while ((ret = lane.queue.Push(rawData, route)) == EventQueue::PushResult::FULL) {
+        if (policy == AsyncDropPolicy::DROP_OLDEST) {
+            if (lane.queue.Pop([] (RawData&) {})) {
+                lane.droppedCnt.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        if (policy == AsyncDropPolicy::BLOCK) {
+            // the sender may be stalled, so the writer never waits longer than MAX_ASYNC_BLOCK_TIME
+            auto deadline = GetBlockDeadline();
+            lane.blockedCnt.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while ((ret = lane.queue.Push(rawData, route)) == EventQueue::PushResult::FULL &&
+                WaitForRoom(lane, deadline)) {}
+            lane.blockedCnt.fetch_sub(1, std::memory_order_relaxed);
+            if (ret != EventQueue::PushResult::FULL) {
+                break;
+            }
+        }
+        lane.droppedCnt.fetch_add(1, std::memory_order_relaxed);
+        return ERR_SEND_FAIL;
+    }
+    if (ret == EventQueue::PushResult::COPY_FAILED) {
+        HILOG_WARN(LOG_CORE, "failed to copy the event into the queue, len=%{public}zu", rawData.GetDataLength());
+        lane.droppedCnt.fetch_add(1, std::memory_order_relaxed);
+        return ERR_RAW_DATA_WROTE_EXCEPTION;
+    }
+    UpdateHighWaterMark(lane);
+    WakeUpSender(lane);
+    return SUCCESS;
+}
+
+uint64_t AsyncSender::GetDroppedCount()
+{
+    uint64_t droppedCnt = 0;
+    for (auto& item : g_lanes) {
+        if (auto lane = item.load(std::memory_order_acquire); lane != nullptr) {
+            droppedCnt += lane->droppedCnt.load(std::memory_order_relaxed);
+        }
+    }
+    return droppedCnt;
+}
+
+bool AsyncSender::SetPriorityLanes(const std::vector<PriorityLaneConfig>& lanes)
+{
+    if (lanes.empty() || lanes.size() > MAX_PRIORITY_LANE_CNT) {
+        HILOG_WARN(LOG_CORE, "count[%{public}zu] of lanes is invalid", lanes.size());
+        return false;
+    }
+    std::vector<EventRule> rules;
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        for (const auto& event : lanes[i].events) {
+            if (!EventRuleTable::RuleParsed(event, static_cast<uint8_t>(i), rules)) {
+                HILOG_WARN(LOG_CORE, "events of lane %{public}zu are invalid", i);
+                return false;
+            }
+        }
+    }
+    auto table = std::make_unique<EventRuleTable>(std::move(rules));
+    std::lock_guard<std::mutex> lock(g_initMutex);
+    if (!LanesConfigured(lanes, std::move(table))) {
+        return false;
+    }
+    g_isAsyncEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+uint32_t AsyncSender::GetPriorityLaneCount()
+{
+    return g_laneCnt.load(std::memory_order_acquire);
+}
+
+bool AsyncSender::GetPriorityLaneStats(uint32_t lane, PriorityLaneStats& stats)
+{
+    auto item = (lane < MAX_PRIORITY_LANE_CNT) ? g_lanes[lane].load(std::memory_order_acquire) : nullptr;
+    if (item == nullptr) {
+        return false;
+    }
+    stats.sentCnt = item->sentCnt.load(std::memory_order_relaxed);
+    stats.failedCnt = item->failedCnt.load(std::memory_order_relaxed);
+    stats.droppedCnt = item->droppedCnt.load(std::memory_order_relaxed);
+    stats.queueHighWaterMark = item->highWaterMark.load(std::memory_order_relaxed);
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "circuit_breaker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <pthread.h>
+
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_CIRCUIT_BREAKER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+inline uint64_t GetMonotonicTimeMills()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+CircuitBreaker& CircuitBreaker::GetInstance()
+{
+    static CircuitBreaker instance;
+    // the mutex must not be kept locked in the child process by the thread which does not exist there
+    static const int atForkRet = pthread_atfork([] { instance.mutex_.lock(); },
+        [] { instance.mutex_.unlock(); }, [] { instance.mutex_.unlock(); });
+    (void)atForkRet;
+    return instance;
+}
+
+void CircuitBreaker::SetParams(bool enabled, uint32_t failureThreshold, uint32_t maxBackoff)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    failureThreshold_ = std::max(failureThreshold, 1U);
+    maxBackoff_ = std::max(maxBackoff, MIN_CIRCUIT_BACKOFF);
+    backoff_ = std::min(backoff_, maxBackoff_);
+    isEnabled_.store(enabled, std::memory_order_relaxed);
+    if (!enabled && state_.load(std::memory_order_relaxed) != CircuitState::CLOSED) {
+        backoff_ = MIN_CIRCUIT_BACKOFF;
+        Transit(CircuitState::CLOSED, GetMonotonicTimeMills());
+    }
+}
+
+bool CircuitBreaker::IsSendAllowed()
+{
+    if (state_.load(std::memory_order_acquire) == CircuitState::CLOSED) {
+        return true;
+    }
+    // the writing threads never wait for each other while the breaker is not closed
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    auto state = state_.load(std::memory_order_relaxed);
+    if (state == CircuitState::CLOSED) {
+        return true;
+    }
+    auto now = GetMonotonicTimeMills();
+    if (now < nextProbeTime_) {
+        return false;
+    }
+    // the probe is allowed again if the result of the last one is never told, eg. it is lost by fork
+    probeCnt_++;
+    nextProbeTime_ = now + maxBackoff_;
+    if (state != CircuitState::HALF_OPEN) {
+        Transit(CircuitState::HALF_OPEN, now);
+    }
+    return true;
+}
+
+void CircuitBreaker::OnSendSucceeded()
+{
+    if (state_.load(std::memory_order_acquire) == CircuitState::CLOSED) {
+        if (consecutiveFailures_.load(std::memory_order_relaxed) != 0) {
+            consecutiveFailures_.store(0, std::memory_order_relaxed);
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_.load(std::memory_order_relaxed) == CircuitState::CLOSED) {
+        return;
+    }
+    backoff_ = MIN_CIRCUIT_BACKOFF;
+    Transit(CircuitState::CLOSED, GetMonotonicTimeMills());
+    HILOG_INFO(LOG_CORE, "hiview is available again, %{public}" PRIu64 " events failed fast",
+        fastFailedCnt_.load(std::memory_order_relaxed));
+}
+
+void CircuitBreaker::OnSendFailed()
+{
+    if (!isEnabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto state = state_.load(std::memory_order_acquire);
+    if (state == CircuitState::OPEN) {
+        return; // failure of the event allowed to send before the breaker is opened
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state == CircuitState::CLOSED &&
+        consecutiveFailures_.fetch_add(1, std::memory_order_relaxed) + 1 < failureThreshold_) {
+        return;
+    }
+    state = state_.load(std::memory_order_relaxed);
+    if (state == CircuitState::OPEN) {
+        return;
+    }
+    // backoff is doubled by each failed probe
+    backoff_ = (state == CircuitState::HALF_OPEN) ? std::min(backoff_ * 2, maxBackoff_) : MIN_CIRCUIT_BACKOFF;
+    auto now = GetMonotonicTimeMills();
+    nextProbeTime_ = now + backoff_;
+    Transit(CircuitState::OPEN, now);
+    if (state == CircuitState::CLOSED) {
+        HILOG_WARN(LOG_CORE, "failed to send events for %{public}u times, fail fast for %{public}u ms",
+            consecutiveFailures_.load(std::memory_order_relaxed), backoff_);
+    }
+}
+
+void CircuitBreaker::OnFastFailed()
+{
+    fastFailedCnt_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool CircuitBreaker::IsClosed() const
+{
+    return state_.load(std::memory_order_acquire) == CircuitState::CLOSED;
+}
+
+uint64_t CircuitBreaker::GetProbeDelay() const
+{
+    if (IsClosed()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = GetMonotonicTimeMills();
+    return (nextProbeTime_ > now) ? (nextProbeTime_ - now) : 0;
+}
+
+void CircuitBreaker::GetStats(CircuitBreakerStats& stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.state = state_.load(std::memory_order_relaxed);
+    stats.openedCnt = openedCnt_;
+    stats.closedCnt = closedCnt_;
+    stats.probeCnt = probeCnt_;
+    stats.fastFailedCnt = fastFailedCnt_.load(std::memory_order_relaxed);
+    stats.lastTransitionTime = lastTransitionTime_;
+    stats.backoff = backoff_;
+}
+
+void CircuitBreaker::Transit(CircuitState state, uint64_t now)
+{
+    if (state == CircuitState::OPEN && state_.load(std::memory_order_relaxed) == CircuitState::CLOSED) {
+        openedCnt_++;
+    } else if (state == CircuitState::CLOSED) {
+        closedCnt_++;
+        consecutiveFailures_.store(0, std::memory_order_relaxed);
+    }
+    lastTransitionTime_ = now;
+    state_.store(state, std::memory_order_release);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
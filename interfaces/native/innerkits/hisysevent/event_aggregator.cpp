@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_aggregator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <pthread.h>
+#include <string>
+#include <time.h>
+
+#include "async_sender.h"
+#include "def.h"
+#include "encoded_param.h"
+#include "event_socket_factory.h"
+#include "hilog/log.h"
+#include "raw_data_base_def.h"
+#include "transport.h"
+#include "write_controller.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_AGGREGATOR"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+namespace {
+constexpr char TIMER_THREAD_NAME[] = "hisysevent_aggr";
+constexpr uint64_t NO_WINDOW_END = UINT64_MAX;
+constexpr uint64_t SEC_TO_MILLS = 1000;
+constexpr uint64_t MILLS_TO_NANOS = 1000000;
+
+inline uint64_t GetMonotonicTimeMills()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// fields of the header have fixed length, and the encoded parameters are delimited by themselves, so that
+// different fields never make up the same key
+void KeyAppended(std::string& key, const void* data, size_t len)
+{
+    (void)key.append(static_cast<const char*>(data), len);
+}
+
+bool IsNumericParam(const ParamDigest::Param& param)
+{
+    return param.valueType != ValueType::UNKNOWN;
+}
+
+bool IsSignedType(uint8_t valueType)
+{
+    return valueType == ValueType::INT8 || valueType == ValueType::INT16 || valueType == ValueType::INT32 ||
+        valueType == ValueType::INT64;
+}
+
+bool IsFloatingType(uint8_t valueType)
+{
+    return valueType == ValueType::FLOAT || valueType == ValueType::DOUBLE;
+}
+
+// sum, min and max of the numeric parameter, min and max are omitted if there is no room for them
+template<typename T>
+int32_t StatEncoded(RawData& data, const std::string& key, T sum, T min, T max, bool isMinMaxEncoded)
+{
+    if (!ParamEncoder::ParamEncoded<T>(data, key, sum)) {
+        return 0;
+    }
+    if (!isMinMaxEncoded || key.length() + sizeof(EventAggregator::MIN_KEY_SUFFIX) - 1 > MAX_PARAM_NAME_LENGTH) {
+        return 1;
+    }
+    int32_t cnt = 1;
+    cnt += ParamEncoder::ParamEncoded<T>(data, key + EventAggregator::MIN_KEY_SUFFIX, min) ? 1 : 0;
+    cnt += ParamEncoder::ParamEncoded<T>(data, key + EventAggregator::MAX_KEY_SUFFIX, max) ? 1 : 0;
+    return cnt;
+}
+}
+
+EventAggregator::EventAggregator()
+{
+    (void)sem_init(&wakeUpSem_, 0, 0);
+}
+
+EventAggregator& EventAggregator::GetInstance()
+{
+    static EventAggregator instance;
+    // the timer thread does not exist in the child process, and the groups will be summarized by the parent
+    static const int atForkRet = pthread_atfork([] { instance.mutex_.lock(); },
+        [] { instance.mutex_.unlock(); }, [] {
+            instance.groups_.clear();
+            (void)sem_init(&instance.wakeUpSem_, 0, 0);
+            instance.isTimerStarted_.store(false, std::memory_order_relaxed);
+            instance.mutex_.unlock();
+        });
+    (void)atForkRet;
+    return instance;
+}
+
+void EventAggregator::SetParams(bool enabled, uint32_t window)
+{
+    window_.store(std::max(window, MIN_AGGREGATION_WINDOW), std::memory_order_relaxed);
+    isEnabled_.store(enabled, std::memory_order_release);
+    if (!enabled) {
+        (void)SendSummaries(true);
+        return;
+    }
+    // the timer may be waiting for the end of the window set before
+    (void)sem_post(&wakeUpSem_);
+}
+
+bool EventAggregator::IsEnabled() const
+{
+    return isEnabled_.load(std::memory_order_acquire);
+}
+
+AggregateResult EventAggregator::Aggregate(const RawData& rawData, const ParamDigest& paramDigest,
+    uint64_t callSite)
+{
+    const auto& params = paramDigest.GetParams();
+    if (paramDigest.GetParamsBegin() < sizeof(int32_t) + sizeof(HiSysEventHeader) + sizeof(int32_t) ||
+        (!params.empty() && params.back().end > rawData.GetDataLength())) {
+        return AggregateResult::TO_SEND;
+    }
+    // the group is identified by the call site and parameters, except the values of numeric ones, the key is
+    // reused by the thread, so that no memory is allocated for the events folded
+    thread_local std::string groupKey;
+    groupKey.clear();
+    auto data = rawData.GetData();
+    auto header = reinterpret_cast<const HiSysEventHeader*>(data + sizeof(int32_t));
+    KeyAppended(groupKey, header->domain, sizeof(header->domain));
+    KeyAppended(groupKey, header->name, sizeof(header->name));
+    KeyAppended(groupKey, &callSite, sizeof(callSite));
+    for (const auto& param : params) {
+        KeyAppended(groupKey, data + param.begin, param.valueBegin - param.begin);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!isEnabled_.load(std::memory_order_relaxed)) {
+        return AggregateResult::TO_SEND;
+    }
+    if (auto iter = groups_.find(groupKey); iter != groups_.end()) {
+        Fold(iter->second, paramDigest);
+        stats_.foldedCnt++;
+        return AggregateResult::FOLDED;
+    }
+    if (groups_.size() >= MAX_AGGREGATION_GROUP_CNT) {
+        stats_.discardedCnt++;
+        return AggregateResult::DISCARDED;
+    }
+    // the event is copied only once for the group, whose summary is encoded from it
+    Group& group = groups_[groupKey];
+    group.windowEnd = GetMonotonicTimeMills() + window_.load(std::memory_order_relaxed);
+    group.firstEvent = rawData;
+    group.paramsBegin = paramDigest.GetParamsBegin();
+    group.params = params;
+    for (const auto& param : params) {
+        if (IsNumericParam(param)) {
+            group.stats.push_back({ param.valueType, param.value, param.value, param.value });
+        }
+    }
+    stats_.sentCnt++;
+    bool isFirstGroup = groups_.size() == 1;
+    lock.unlock();
+    // the timer waits without timeout while there is no group
+    if (StartTimer() && isFirstGroup) {
+        (void)sem_post(&wakeUpSem_);
+    }
+    return AggregateResult::TO_SEND;
+}
+
+void EventAggregator::GetStats(AggregationStats& stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats = stats_;
+}
+
+void EventAggregator::Fold(Group& group, const ParamDigest& paramDigest)
+{
+    // events of the same group have the same parameters, so are their numeric ones
+    bool isFirstFolded = group.foldedCnt++ == 0;
+    size_t statIndex = 0;
+    for (const auto& param : paramDigest.GetParams()) {
+        if (!IsNumericParam(param)) {
+            continue;
+        }
+        auto& stat = group.stats[statIndex++];
+        const auto& value = param.value;
+        if (isFirstFolded) {
+            stat.sum = value;
+            stat.min = value;
+            stat.max = value;
+            continue;
+        }
+        if (IsSignedType(stat.valueType)) {
+            // the sum wraps around as the unsigned one instead of overflowing
+            stat.sum.int64Value = static_cast<int64_t>(static_cast<uint64_t>(stat.sum.int64Value) +
+                static_cast<uint64_t>(value.int64Value));
+            stat.min.int64Value = std::min(stat.min.int64Value, value.int64Value);
+            stat.max.int64Value = std::max(stat.max.int64Value, value.int64Value);
+        } else if (IsFloatingType(stat.valueType)) {
+            stat.sum.floatingValue += value.floatingValue;
+            stat.min.floatingValue = std::min(stat.min.floatingValue, value.floatingValue);
+            stat.max.floatingValue = std::max(stat.max.floatingValue, value.floatingValue);
+        } else {
+            stat.sum.uint64Value += value.uint64Value;
+            stat.min.uint64Value = std::min(stat.min.uint64Value, value.uint64Value);
+            stat.max.uint64Value = std::max(stat.max.uint64Value, value.uint64Value);
+        }
+    }
+}
+
+uint64_t EventAggregator::TakeExpiredGroups(bool isAll, std::vector<Group>& expiredGroups)
+{
+    auto now = GetMonotonicTimeMills();
+    uint64_t nextWindowEnd = NO_WINDOW_END;
+    for (auto iter = groups_.begin(); iter != groups_.end();) {
+        if (!isAll && iter->second.windowEnd > now) {
+            nextWindowEnd = std::min(nextWindowEnd, iter->second.windowEnd);
+            ++iter;
+            continue;
+        }
+        if (iter->second.foldedCnt > 0) {
+            expiredGroups.push_back(std::move(iter->second));
+        }
+        iter = groups_.erase(iter);
+    }
+    return nextWindowEnd;
+}
+
+uint64_t EventAggregator::SendSummaries(bool isAll)
+{
+    std::vector<Group> expiredGroups;
+    uint64_t nextWindowEnd = NO_WINDOW_END;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nextWindowEnd = TakeExpiredGroups(isAll, expiredGroups);
+        stats_.summaryCnt += expiredGroups.size();
+    }
+    RawData summary;
+    for (const auto& group : expiredGroups) {
+        if (!SummaryEncoded(group, summary)) {
+            continue;
+        }
+        auto route = EventSocketFactory::GetEventRoute(summary);
+        int ret = AsyncSender::IsEnabled() ? AsyncSender::Submit(summary, route) :
+            Transport::GetInstance().SendData(summary, route);
+        if (ret != SUCCESS) {
+            HILOG_DEBUG(LOG_CORE, "failed to send summary of events, ret=%{public}d", ret);
+        }
+    }
+    return nextWindowEnd;
+}
+
+bool EventAggregator::SummaryEncoded(const Group& group, RawData& summary)
+{
+    auto data = group.firstEvent.GetData();
+    summary.Reset();
+    if (!summary.Append(data, group.paramsBegin)) {
+        return false;
+    }
+    // the summary is stamped with the end of the window
+    auto header = reinterpret_cast<struct HiSysEventHeader*>(summary.GetData() + sizeof(int32_t));
+    header->timestamp = WriteController::GetCurrentTimeMills();
+
+    // min and max are encoded only if the count of parameters is still in limit
+    size_t extraParamCnt = MAX_PARAM_NUMBER - std::min<size_t>(MAX_PARAM_NUMBER, group.params.size() + 1);
+    int32_t paramCnt = 0;
+    size_t statIndex = 0;
+    for (const auto& param : group.params) {
+        if (!IsNumericParam(param)) {
+            paramCnt += summary.Append(data + param.begin, param.end - param.begin) ? 1 : 0;
+            continue;
+        }
+        const auto& stat = group.stats[statIndex++];
+        // the key is followed by the value type
+        std::string key(reinterpret_cast<const char*>(data + param.valueBegin - param.keyLen - 1), param.keyLen);
+        bool isMinMaxEncoded = extraParamCnt >= 2; // 2: min and max
+        extraParamCnt -= isMinMaxEncoded ? 2 : 0; // 2: min and max
+        if (IsSignedType(stat.valueType)) {
+            paramCnt += StatEncoded(summary, key, stat.sum.int64Value, stat.min.int64Value, stat.max.int64Value,
+                isMinMaxEncoded);
+        } else if (IsFloatingType(stat.valueType)) {
+            paramCnt += StatEncoded(summary, key, stat.sum.floatingValue, stat.min.floatingValue,
+                stat.max.floatingValue, isMinMaxEncoded);
+        } else {
+            paramCnt += StatEncoded(summary, key, stat.sum.uint64Value, stat.min.uint64Value, stat.max.uint64Value,
+                isMinMaxEncoded);
+        }
+    }
+    if (!ParamEncoder::ParamEncoded<uint64_t>(summary, FOLDED_CNT_KEY, group.foldedCnt)) {
+        return false;
+    }
+    paramCnt++;
+    auto blockSize = static_cast<int32_t>(summary.GetDataLength());
+    size_t paramCntPos = group.paramsBegin - sizeof(int32_t);
+    return summary.Update(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t), 0) &&
+        summary.Update(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(int32_t), paramCntPos);
+}
+
+bool EventAggregator::StartTimer()
+{
+    if (isTimerStarted_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isTimerStarted_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    pthread_t tid;
+    if (pthread_create(&tid, nullptr, SendInBackground, this) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to create thread to send summaries, errno=%{public}d", errno);
+        return false;
+    }
+    (void)pthread_detach(tid);
+    isTimerStarted_.store(true, std::memory_order_release);
+    return true;
+}
+
+void EventAggregator::SendSummariesInBackground()
+{
+    while (true) {
+        uint64_t nextWindowEnd = SendSummaries(false);
+        if (nextWindowEnd == NO_WINDOW_END) {
+            while (sem_wait(&wakeUpSem_) != 0 && errno == EINTR) {}
+            continue;
+        }
+        uint64_t now = GetMonotonicTimeMills();
+        uint64_t delay = (nextWindowEnd > now) ? (nextWindowEnd - now) : 0;
+        struct timespec ts = { 0, 0 };
+        (void)clock_gettime(CLOCK_REALTIME, &ts);
+        uint64_t nanos = static_cast<uint64_t>(ts.tv_nsec) + (delay % SEC_TO_MILLS) * MILLS_TO_NANOS;
+        ts.tv_sec += static_cast<time_t>(delay / SEC_TO_MILLS + nanos / (SEC_TO_MILLS * MILLS_TO_NANOS));
+        ts.tv_nsec = static_cast<long>(nanos % (SEC_TO_MILLS * MILLS_TO_NANOS));
+        while (sem_timedwait(&wakeUpSem_, &ts) != 0 && errno == EINTR) {}
+    }
+}
+
+void* EventAggregator::SendInBackground(void* arg)
+{
+    (void)pthread_setname_np(pthread_self(), TIMER_THREAD_NAME);
+    static_cast<EventAggregator*>(arg)->SendSummariesInBackground();
+    return nullptr;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_buffer_cache.h"
+
+#include <atomic>
+
+#include "def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+std::atomic<bool> g_isCacheEnabled { true };
+thread_local std::shared_ptr<RawData> g_cachedBuffer = nullptr;
+}
+
+std::shared_ptr<RawData> EventBufferCache::Borrow()
+{
+    if (!g_isCacheEnabled.load(std::memory_order_relaxed)) {
+        return std::make_shared<RawData>();
+    }
+    // drop the buffer which has been expanded by an oversized event to bound the memory kept by each thread
+    if (g_cachedBuffer != nullptr && g_cachedBuffer->GetCapacity() > MAX_DATA_SIZE) {
+        g_cachedBuffer = nullptr;
+    }
+    if (g_cachedBuffer == nullptr) {
+        g_cachedBuffer = std::make_shared<RawData>();
+        return g_cachedBuffer;
+    }
+    // the cached buffer is still held by another event base, eg. writing event nestedly
+    if (g_cachedBuffer.use_count() > 1) {
+        return std::make_shared<RawData>();
+    }
+    g_cachedBuffer->Reset();
+    return g_cachedBuffer;
+}
+
+void EventBufferCache::SetEnabled(bool enabled)
+{
+    g_isCacheEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool EventBufferCache::IsEnabled()
+{
+    return g_isCacheEnabled.load(std::memory_order_relaxed);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
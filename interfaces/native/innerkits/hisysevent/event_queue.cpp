@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_queue.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr size_t MAX_RETAINED_CAPACITY = 4 * 1024; // 4K
+}
+
+EventQueue::EventQueue(uint32_t depth) : depth_(depth), slots_(std::make_unique<Slot[]>(depth))
+{
+    Reset();
+}
+
+EventQueue::PushResult EventQueue::Push(RawData& rawData, const EventRoute& route)
+{
+    auto pos = pushPos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots_[pos % depth_];
+        auto diff = static_cast<int64_t>(slot->seq.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (pushPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return PushResult::FULL;
+        } else {
+            pos = pushPos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->data.Reset();
+    // the slot claimed must be released anyway, otherwise the ones behind it would never be popped
+    bool isCopied = slot->data.Append(rawData.GetData(), rawData.GetDataLength());
+    if (!isCopied) {
+        slot->data = RawData();
+    }
+    slot->route = route;
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return isCopied ? PushResult::PUSHED : PushResult::COPY_FAILED;
+}
+
+bool EventQueue::IsEmpty() const
+{
+    auto pos = popPos_.load(std::memory_order_relaxed);
+    return slots_[pos % depth_].seq.load(std::memory_order_acquire) != pos + 1;
+}
+
+uint32_t EventQueue::GetSize() const
+{
+    // slots claimed but not yet pushed or popped are counted as well
+    auto popPos = popPos_.load(std::memory_order_relaxed);
+    auto pushPos = pushPos_.load(std::memory_order_relaxed);
+    return (pushPos > popPos) ? static_cast<uint32_t>(std::min<uint64_t>(pushPos - popPos, depth_)) : 0;
+}
+
+void EventQueue::Reset()
+{
+    for (uint32_t i = 0; i < depth_; i++) {
+        slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    pushPos_.store(0, std::memory_order_relaxed);
+    popPos_.store(0, std::memory_order_relaxed);
+}
+
+void EventQueue::Release(Slot& slot, uint64_t pos)
+{
+    // drop the buffer which has been expanded by a big event to bound the memory kept by the queue
+    if (slot.data.GetCapacity() > MAX_RETAINED_CAPACITY) {
+        slot.data = RawData();
+    }
+    slot.seq.store(pos + depth_, std::memory_order_release);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
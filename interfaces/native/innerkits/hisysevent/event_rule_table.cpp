@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_rule_table.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "def.h"
+#include "hilog/log.h"
+#include "hisysevent.h"
+#include "raw_data_base_def.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "EVENT_RULE_TABLE"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char COMMENT_MARK = '#';
+
+// same as the names checked by StringFilter, which begin with a letter
+bool IsValidConfigName(const std::string& name, size_t maxLength)
+{
+    return !name.empty() && name.length() <= maxLength && std::isalpha(static_cast<unsigned char>(name[0])) &&
+        std::all_of(name.begin(), name.end(), [] (char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        });
+}
+
+bool TypeMaskParsed(const std::string& typeName, uint8_t& typeMask)
+{
+    static const std::unordered_map<std::string, int> types = {
+        { "FAULT", HiSysEvent::EventType::FAULT },
+        { "STATISTIC", HiSysEvent::EventType::STATISTIC },
+        { "SECURITY", HiSysEvent::EventType::SECURITY },
+        { "BEHAVIOR", HiSysEvent::EventType::BEHAVIOR },
+    };
+    auto iter = types.find(typeName);
+    if (iter == types.end()) {
+        return false;
+    }
+    typeMask |= EventRuleTable::GetTypeMask(iter->second);
+    return true;
+}
+}
+
+EventRuleTable::EventRuleTable(const EventRule* rules, size_t cnt) : rules_(rules), cnt_(cnt)
+{
+}
+
+EventRuleTable::EventRuleTable(std::vector<EventRule> rules) : storage_(std::move(rules))
+{
+    std::stable_sort(storage_.begin(), storage_.end(), [] (const EventRule& left, const EventRule& right) {
+        return left.hash < right.hash;
+    });
+    rules_ = storage_.data();
+    cnt_ = storage_.size();
+}
+
+const EventRule* EventRuleTable::Find(std::string_view domain, std::string_view name, int type) const
+{
+    uint8_t typeMask = GetTypeMask(type);
+    if (auto rule = FindByHash(GetEventHash(domain, name), typeMask); rule != nullptr) {
+        return rule;
+    }
+    return FindByHash(GetEventHash(domain, ANY_EVENT_NAME), typeMask);
+}
+
+const EventRule* EventRuleTable::Find(const Encoded::RawData& data) const
+{
+    if (data.GetDataLength() < sizeof(int32_t) + sizeof(struct Encoded::HiSysEventHeader)) {
+        return nullptr;
+    }
+    auto header = reinterpret_cast<const struct Encoded::HiSysEventHeader*>(data.GetData() + sizeof(int32_t));
+    std::string_view domain(header->domain, strnlen(header->domain, sizeof(header->domain)));
+    std::string_view name(header->name, strnlen(header->name, sizeof(header->name)));
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    return Find(domain, name, type);
+}
+
+size_t EventRuleTable::GetRuleCount() const
+{
+    return cnt_;
+}
+
+const EventRule* EventRuleTable::FindByHash(uint64_t hash, uint8_t typeMask) const
+{
+    auto end = rules_ + cnt_;
+    auto iter = std::lower_bound(rules_, end, hash, [] (const EventRule& rule, uint64_t hash) {
+        return rule.hash < hash;
+    });
+    for (; iter != end && iter->hash == hash; ++iter) {
+        if ((iter->typeMask & typeMask) != 0) {
+            return iter;
+        }
+    }
+    return nullptr;
+}
+
+bool EventRuleTable::RuleParsed(const std::string& line, uint8_t value, std::vector<EventRule>& rules)
+{
+    std::istringstream tokens(line.substr(0, line.find(COMMENT_MARK)));
+    std::string domain;
+    if (!(tokens >> domain)) {
+        return true; // empty line or comment
+    }
+    std::string name;
+    if (!(tokens >> name) || !IsValidConfigName(domain, MAX_DOMAIN_LENGTH) ||
+        (name != ANY_EVENT_NAME && !IsValidConfigName(name, MAX_EVENT_NAME_LENGTH))) {
+        return false;
+    }
+    uint8_t typeMask = 0;
+    for (std::string typeName; tokens >> typeName;) {
+        if (!TypeMaskParsed(typeName, typeMask)) {
+            return false;
+        }
+    }
+    rules.push_back(Rule(domain, name, (typeMask == 0) ? ANY_TYPE_MASK : typeMask, value));
+    return true;
+}
+
+std::unique_ptr<EventRuleTable> EventRuleTable::Load(const std::string& configPath, uint8_t value)
+{
+    std::ifstream fin(configPath);
+    if (!fin.is_open()) {
+        return nullptr;
+    }
+    std::vector<EventRule> rules;
+    size_t lineNo = 0;
+    for (std::string line; std::getline(fin, line);) {
+        ++lineNo;
+        if (!RuleParsed(line, value, rules)) {
+            HILOG_WARN(LOG_CORE, "line %{public}zu of config of event rules is invalid", lineNo);
+            return nullptr;
+        }
+    }
+    return std::make_unique<EventRuleTable>(std::move(rules));
+}
+} // namespace HiviewDFX
+} // namespace OHOS
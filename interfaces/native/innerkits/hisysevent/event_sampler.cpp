@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_sampler.h"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "event_rule_table.h"
+#include "hilog/log.h"
+#include "hisysevent.h"
+#ifdef HIVIEWDFX_HITRACE_ENABLED
+#include "hitrace/trace.h"
+#endif
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_SAMPLER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+struct PolicyItem {
+    uint32_t rate = FULL_SAMPLING_RATE;
+    SamplingMode mode = SamplingMode::SAMPLE_RANDOM;
+    std::atomic<uint64_t> writtenCnt { 0 };
+    std::atomic<uint64_t> keptCnt { 0 };
+    std::atomic<uint64_t> droppedCnt { 0 };
+};
+
+struct SamplingConfig {
+    std::unique_ptr<EventRuleTable> table;
+    std::unique_ptr<PolicyItem[]> policies;
+    size_t policyCnt = 0;
+};
+
+// configs set are never freed, since the replaced ones may be still read by the writing threads
+std::atomic<SamplingConfig*> g_config { nullptr };
+std::mutex g_configMutex;
+std::list<std::unique_ptr<SamplingConfig>> g_configs;
+
+// xorshift64*, which is good enough to sample and much cheaper than the generators of std
+uint64_t NextRandom()
+{
+    thread_local uint64_t state = (static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count()) ^ reinterpret_cast<uintptr_t>(&state)) | 1;
+    state ^= state >> 12; // 12: shift of xorshift64*
+    state ^= state << 25; // 25: shift of xorshift64*
+    state ^= state >> 27; // 27: shift of xorshift64*
+    return state * 0x2545f4914f6cdd1dULL;
+}
+
+// finalizer of splitmix64, so that any bits of trace id decide the event is kept or not
+uint64_t MixedHash(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL; // 30: shift of splitmix64
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL; // 27: shift of splitmix64
+    return value ^ (value >> 31); // 31: shift of splitmix64
+}
+
+bool TraceIdGot(uint64_t& traceId)
+{
+#ifdef HIVIEWDFX_HITRACE_ENABLED
+    HiTraceId hitraceId = HiTraceChain::GetId();
+    if (hitraceId.IsValid()) {
+        traceId = hitraceId.GetChainId();
+        return true;
+    }
+#else
+    (void)traceId;
+#endif
+    return false;
+}
+
+bool IsValidPolicy(const SamplingPolicy& policy)
+{
+    return policy.rate <= FULL_SAMPLING_RATE && policy.mode >= SamplingMode::SAMPLE_RANDOM &&
+        policy.mode <= SamplingMode::SAMPLE_BY_TRACE;
+}
+}
+
+bool EventSampler::SetPolicies(const std::vector<SamplingPolicy>& policies)
+{
+    if (policies.size() > MAX_SAMPLING_POLICY_CNT) {
+        HILOG_WARN(LOG_CORE, "count[%{public}zu] of sampling policies is invalid", policies.size());
+        return false;
+    }
+    std::unique_ptr<SamplingConfig> config;
+    if (!policies.empty()) {
+        std::vector<EventRule> rules;
+        config = std::make_unique<SamplingConfig>();
+        config->policies = std::make_unique<PolicyItem[]>(policies.size());
+        config->policyCnt = policies.size();
+        for (size_t i = 0; i < policies.size(); ++i) {
+            if (!IsValidPolicy(policies[i])) {
+                HILOG_WARN(LOG_CORE, "rate or mode of sampling policy %{public}zu is invalid", i);
+                return false;
+            }
+            for (const auto& event : policies[i].events) {
+                if (!EventRuleTable::RuleParsed(event, static_cast<uint8_t>(i), rules)) {
+                    HILOG_WARN(LOG_CORE, "events of sampling policy %{public}zu are invalid", i);
+                    return false;
+                }
+            }
+            config->policies[i].rate = policies[i].rate;
+            config->policies[i].mode = policies[i].mode;
+        }
+        config->table = std::make_unique<EventRuleTable>(std::move(rules));
+    }
+    std::lock_guard<std::mutex> lock(g_configMutex);
+    g_config.store(config.get(), std::memory_order_release);
+    if (config != nullptr) {
+        g_configs.push_back(std::move(config));
+    }
+    return true;
+}
+
+bool EventSampler::IsEnabled()
+{
+    return g_config.load(std::memory_order_acquire) != nullptr;
+}
+
+bool EventSampler::IsSampledIn(std::string_view domain, std::string_view name, uint32_t& rate)
+{
+    rate = FULL_SAMPLING_RATE;
+    auto config = g_config.load(std::memory_order_acquire);
+    if (config == nullptr) {
+        return true;
+    }
+    auto rule = config->table->Find(domain, name, HiSysEvent::EventType::BEHAVIOR);
+    if (rule == nullptr) {
+        return true;
+    }
+    auto& policy = config->policies[rule->value];
+    uint64_t seed = 0;
+    uint64_t traceId = 0;
+    if (policy.mode == SamplingMode::SAMPLE_DETERMINISTIC) {
+        // the event is kept each time the accumulated rate passes a whole one
+        seed = policy.writtenCnt.fetch_add(1, std::memory_order_relaxed) * policy.rate;
+    } else if (policy.mode == SamplingMode::SAMPLE_BY_TRACE && TraceIdGot(traceId)) {
+        seed = MixedHash(traceId);
+    } else {
+        seed = NextRandom();
+    }
+    rate = policy.rate;
+    if (seed % FULL_SAMPLING_RATE < policy.rate) {
+        policy.keptCnt.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    policy.droppedCnt.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool EventSampler::GetStats(uint32_t policy, SamplingStats& stats)
+{
+    auto config = g_config.load(std::memory_order_acquire);
+    if (config == nullptr || policy >= config->policyCnt) {
+        return false;
+    }
+    stats.keptCnt = config->policies[policy].keptCnt.load(std::memory_order_relaxed);
+    stats.droppedCnt = config->policies[policy].droppedCnt.load(std::memory_order_relaxed);
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
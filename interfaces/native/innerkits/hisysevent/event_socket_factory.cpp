@@ -16,14 +16,21 @@
 #include "event_socket_factory.h"
 
 #include "def.h"
+#include "event_rule_table.h"
 #include "hisysevent.h"
 #include "hilog/log.h"
 #include "raw_data_base_def.h"
 
-#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 
+#include "securec.h"
+
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
 
@@ -33,90 +40,169 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
-struct sockaddr_un normalAddr = {
-    .sun_family = AF_UNIX,
-    .sun_path = "/dev/unix/socket/hisysevent",
+struct ServerSockets {
+    EventSocket normal;
+    EventSocket higherPriority;
 };
 
-struct sockaddr_un higherPriorityAddr = {
-    .sun_family = AF_UNIX,
-    .sun_path = "/dev/unix/socket/hisysevent_fast",
+const ServerSockets DEFAULT_SERVER_SOCKETS = {
+    .normal = { .sun_family = AF_UNIX, .sun_path = "/dev/unix/socket/hisysevent" },
+    .higherPriority = { .sun_family = AF_UNIX, .sun_path = "/dev/unix/socket/hisysevent_fast" },
 };
 
-inline bool IsHigherPriorityEventName(const std::list<std::string>& events, const std::string& name)
+// sockets are never changed once published, and the replaced ones are never freed since they may be still
+// used by the sending threads, so that paths are read without lock
+std::atomic<const ServerSockets*> g_serverSockets { &DEFAULT_SERVER_SOCKETS };
+std::mutex g_serverSocketsMutex;
+std::list<std::unique_ptr<ServerSockets>> g_publishedServerSockets;
+std::atomic<uint32_t> g_socketPathGeneration { 0 };
+
+bool IsValidSocketPath(const std::string& path)
 {
-    auto iter = std::find(events.begin(), events.end(), name);
-    return iter != events.end();
+    return !path.empty() && path.length() < sizeof(EventSocket::sun_path);
 }
 
-bool IsHigherPriorityAafwkEvent(const std::string& name)
+void InitServerSocket(EventSocket& socket, const std::string& path)
 {
-    static std::list<std::string> events {
-        "APP_INPUT_BLOCK", "BUSSINESS_THREAD_BLOCK_3S", "BUSSINESS_THREAD_BLOCK_6S",
-        "LIFECYCLE_HALF_TIMEOUT", "LIFECYCLE_TIMEOUT", "THREAD_BLOCK_3S", "THREAD_BLOCK_6S" };
-    return IsHigherPriorityEventName(events, name);
+    socket.sun_family = AF_UNIX;
+    (void)memset_s(socket.sun_path, sizeof(socket.sun_path), 0, sizeof(socket.sun_path));
+    (void)memcpy_s(socket.sun_path, sizeof(socket.sun_path), path.c_str(), path.length());
 }
 
-bool IsHigerPriorityAceEvent(const std::string& name)
+constexpr char HIGHER_PRIORITY_EVENTS_CONFIG[] = "/system/etc/hiview/hisysevent_priority_events.cfg";
+constexpr uint8_t HIGHER_PRIORITY = 1;
+
+constexpr EventRule Rule(std::string_view domain, std::string_view name,
+    uint8_t typeMask = EventRuleTable::ANY_TYPE_MASK)
 {
-    static std::list<std::string> events {
-        "UI_BLOCK_3S", "UI_BLOCK_6S", "UI_BLOCK_RECOVERED" };
-    return IsHigherPriorityEventName(events, name);
+    return EventRuleTable::Rule(domain, name, typeMask, HIGHER_PRIORITY);
 }
 
-bool IsHigerPriorityFrameworkEvent(const std::string& name)
+constexpr auto BUILT_IN_RULES = EventRuleTable::SortedRules(std::array {
+    Rule("AAFWK", "APP_INPUT_BLOCK"),
+    Rule("AAFWK", "BUSSINESS_THREAD_BLOCK_3S"),
+    Rule("AAFWK", "BUSSINESS_THREAD_BLOCK_6S"),
+    Rule("AAFWK", "LIFECYCLE_HALF_TIMEOUT"),
+    Rule("AAFWK", "LIFECYCLE_TIMEOUT"),
+    Rule("AAFWK", "THREAD_BLOCK_3S"),
+    Rule("AAFWK", "THREAD_BLOCK_6S"),
+    Rule("ACE", "UI_BLOCK_3S"),
+    Rule("ACE", "UI_BLOCK_6S"),
+    Rule("ACE", "UI_BLOCK_RECOVERED"),
+    Rule("FRAMEWORK", "IPC_FULL"),
+    Rule("FRAMEWORK", "IPC_FULL_WARNING"),
+    Rule("FRAMEWORK", "SERVICE_BLOCK"),
+    Rule("FRAMEWORK", "SERVICE_TIMEOUT"),
+    Rule("FRAMEWORK", "SERVICE_WARNING"),
+    Rule("RELIABILITY", EventRuleTable::ANY_EVENT_NAME, EventRuleTable::GetTypeMask(HiSysEvent::EventType::FAULT)),
+    Rule("GRAPHIC", "NO_DRAW"),
+    Rule("MULTIMODALINPUT", "TARGET_POINTER_EVENT_FAILURE"),
+    Rule("POWER", "SCREEN_ON_TIMEOUT"),
+    Rule("WINDOWMANAGER", "NO_FOCUS_WINDOW"),
+    Rule("SCHEDULE_EXT", "SYSTEM_LOAD_LEVEL_CHANGED"),
+});
+static_assert(EventRuleTable::IsCollisionFree(BUILT_IN_RULES), "hashes of built-in higher priority events collide");
+
+const EventRuleTable BUILT_IN_RULE_TABLE(BUILT_IN_RULES.data(), BUILT_IN_RULES.size());
+
+// tables loaded are never freed, since the replaced ones may be still read by the writing threads
+std::atomic<const EventRuleTable*> g_ruleTable { &BUILT_IN_RULE_TABLE };
+std::mutex g_ruleTableMutex;
+std::list<std::unique_ptr<EventRuleTable>> g_loadedRuleTables;
+std::once_flag g_defaultConfigFlag;
+
+void ReplaceRuleTable(std::unique_ptr<EventRuleTable> table)
 {
-    static std::list<std::string> events {
-        "IPC_FULL", "IPC_FULL_WARNING", "SERVICE_BLOCK", "SERVICE_TIMEOUT", "SERVICE_WARNING" };
-    return IsHigherPriorityEventName(events, name);
+    std::lock_guard<std::mutex> lock(g_ruleTableMutex);
+    g_ruleTable.store((table == nullptr) ? &BUILT_IN_RULE_TABLE : table.get(), std::memory_order_release);
+    if (table != nullptr) {
+        g_loadedRuleTables.push_back(std::move(table));
+    }
 }
 
-bool IsHigherPriorityEvent(const std::string& domain, const std::string& name, int type)
+void LoadDefaultRuleTable()
 {
-    if (domain == "AAFWK") {
-        return IsHigherPriorityAafwkEvent(name);
-    } else if (domain == "ACE") {
-        return IsHigerPriorityAceEvent(name);
-    } else if (domain == "FRAMEWORK") {
-        return IsHigerPriorityFrameworkEvent(name);
-    } else if (domain == "RELIABILITY") {
-        return type == HiSysEvent::EventType::FAULT;
-    } else if (domain == "GRAPHIC") {
-        return name == "NO_DRAW";
-    } else if (domain == "MULTIMODALINPUT") {
-        return name == "TARGET_POINTER_EVENT_FAILURE";
-    } else if (domain == "POWER") {
-        return name == "SCREEN_ON_TIMEOUT";
-    } else if (domain == "WINDOWMANAGER") {
-        return name == "NO_FOCUS_WINDOW";
-    } else if (domain == "SCHEDULE_EXT") {
-        return name == "SYSTEM_LOAD_LEVEL_CHANGED";
-    } else {
-        return false;
+    std::call_once(g_defaultConfigFlag, [] {
+        // the built-in events are used if the config file does not exist
+        if (auto table = EventRuleTable::Load(HIGHER_PRIORITY_EVENTS_CONFIG, HIGHER_PRIORITY); table != nullptr) {
+            ReplaceRuleTable(std::move(table));
+        }
+    });
+}
+}
+
+const EventSocket& EventSocketFactory::GetEventSocket(RawData& data)
+{
+    LoadDefaultRuleTable();
+    return GetEventSocket(g_ruleTable.load(std::memory_order_acquire)->Find(data) != nullptr);
+}
+
+const EventSocket& EventSocketFactory::GetEventSocket(bool isHigherPriority)
+{
+    auto sockets = g_serverSockets.load(std::memory_order_acquire);
+    return isHigherPriority ? sockets->higherPriority : sockets->normal;
+}
+
+EventRoute EventSocketFactory::GetEventRoute(std::string_view domain, std::string_view name, int type)
+{
+    bool isHigherPriority = IsHigherPriorityEvent(domain, name, type);
+    return { &GetEventSocket(isHigherPriority), isHigherPriority || type == HiSysEvent::EventType::FAULT };
+}
+
+EventRoute EventSocketFactory::GetEventRoute(RawData& data)
+{
+    if (data.GetDataLength() < sizeof(int32_t) + sizeof(struct HiSysEventHeader)) {
+        return { &GetEventSocket(false), false };
     }
+    auto header = reinterpret_cast<const struct HiSysEventHeader*>(data.GetData() + sizeof(int32_t));
+    std::string_view domain(header->domain, strnlen(header->domain, sizeof(header->domain)));
+    std::string_view name(header->name, strnlen(header->name, sizeof(header->name)));
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    return GetEventRoute(domain, name, type);
 }
 
-void ParseEventInfo(RawData& data, std::string& domain, std::string& name, int& type)
+bool EventSocketFactory::IsHigherPriorityEvent(std::string_view domain, std::string_view name, int type)
 {
-    if (size_t len = data.GetDataLength(); len < sizeof(int32_t) + sizeof(struct HiSysEventHeader)) {
-        HILOG_WARN(LOG_CORE, "length[%{public}zu] of data is invalid", len);
-        return;
+    LoadDefaultRuleTable();
+    return g_ruleTable.load(std::memory_order_acquire)->Find(domain, name, type) != nullptr;
+}
+
+bool EventSocketFactory::LoadHigherPriorityEvents(const std::string& configPath)
+{
+    // the default config is loaded first, so that it never replaces the one loaded here
+    LoadDefaultRuleTable();
+    if (configPath.empty()) {
+        ReplaceRuleTable(nullptr);
+        return true;
+    }
+    auto table = EventRuleTable::Load(configPath, HIGHER_PRIORITY);
+    if (table == nullptr) {
+        HILOG_WARN(LOG_CORE, "failed to load higher priority events, keep the ones in use");
+        return false;
     }
-    auto originalData = data.GetData();
-    struct HiSysEventHeader header = *(reinterpret_cast<struct HiSysEventHeader*>(originalData + sizeof(int32_t)));
-    domain = std::string(header.domain);
-    name = std::string(header.name);
-    type = static_cast<int>(header.type) + 1; // transform type to HiSysEvent::EventType
+    ReplaceRuleTable(std::move(table));
+    return true;
 }
+
+bool EventSocketFactory::SetSocketPath(const std::string& normalPath, const std::string& higherPriorityPath)
+{
+    if (!IsValidSocketPath(normalPath) || !IsValidSocketPath(higherPriorityPath)) {
+        HILOG_WARN(LOG_CORE, "path of socket is invalid");
+        return false;
+    }
+    auto sockets = std::make_unique<ServerSockets>();
+    InitServerSocket(sockets->normal, normalPath);
+    InitServerSocket(sockets->higherPriority, higherPriorityPath);
+    std::lock_guard<std::mutex> lock(g_serverSocketsMutex);
+    g_serverSockets.store(sockets.get(), std::memory_order_release);
+    g_publishedServerSockets.push_back(std::move(sockets));
+    g_socketPathGeneration.fetch_add(1, std::memory_order_release);
+    return true;
 }
 
-EventSocket& EventSocketFactory::GetEventSocket(RawData& data)
+uint32_t EventSocketFactory::GetSocketPathGeneration()
 {
-    std::string domain;
-    std::string name;
-    int type = HiSysEvent::EventType::FAULT;
-    ParseEventInfo(data, domain, name, type);
-    return IsHigherPriorityEvent(domain, name, type) ? higherPriorityAddr : normalAddr;
+    return g_socketPathGeneration.load(std::memory_order_acquire);
 }
 }
 }
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_spool.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cinttypes>
+#include <fcntl.h>
+#include <pthread.h>
+#include <securec.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "def.h"
+#include "hilog/log.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_SPOOL"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+namespace {
+constexpr uint32_t SPOOL_MAGIC = 0x4C4F5053; // "SPOL" in little endian
+constexpr uint32_t SPOOL_VERSION = 1;
+constexpr uint32_t RECORD_ALIGN = 8;
+constexpr uint32_t WRAP_MARK = UINT32_MAX; // length of the record telling the ring continues from the beginning
+constexpr uint64_t INIT_CURSOR = 1ULL << 32; // 32: sequence begins with 1, never matched by zeros of a new file
+
+struct RecordHeader {
+    uint32_t len;       // length of the event, or WRAP_MARK
+    uint32_t seq;       // sequence of the event, increased by one from the oldest record
+    uint32_t checksum;  // crc32 of the length, sequence and event
+    uint32_t reserved;
+};
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = [] { // 256: one entry for each byte
+    constexpr uint32_t polynomial = 0xEDB88320;
+    std::array<uint32_t, 256> table {}; // 256: one entry for each byte
+    for (uint32_t i = 0; i < table.size(); ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) { // 8: bits of a byte
+            crc = (crc & 1) ? ((crc >> 1) ^ polynomial) : (crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+uint32_t UpdateCrc(uint32_t crc, const uint8_t* data, size_t len)
+{
+    for (size_t i = 0; i < len; ++i) {
+        crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8); // 8: bits of a byte
+    }
+    return crc;
+}
+
+uint32_t GetChecksum(uint32_t len, uint32_t seq, const uint8_t* data)
+{
+    uint32_t crc = UINT32_MAX;
+    crc = UpdateCrc(crc, reinterpret_cast<const uint8_t*>(&len), sizeof(len));
+    crc = UpdateCrc(crc, reinterpret_cast<const uint8_t*>(&seq), sizeof(seq));
+    if (len != WRAP_MARK) {
+        crc = UpdateCrc(crc, data, len);
+    }
+    return ~crc;
+}
+
+inline uint32_t GetRecordSize(uint32_t len)
+{
+    return (static_cast<uint32_t>(sizeof(RecordHeader)) + len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+}
+
+struct EventSpool::FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t reserved;
+    std::atomic<uint64_t> cursor; // sequence and position of the oldest record, stored at once
+};
+
+EventSpool& EventSpool::GetInstance()
+{
+    static EventSpool instance;
+    // the spool file is left to the parent process, since records must not be appended by both of them
+    static const int atForkRet = pthread_atfork([] { instance.mutex_.lock(); },
+        [] { instance.mutex_.unlock(); }, [] {
+            instance.Unmap();
+            instance.mutex_.unlock();
+        });
+    (void)atForkRet;
+    return instance;
+}
+
+bool EventSpool::Open(const std::string& path, uint32_t capacity)
+{
+    if (path.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isOpened_.load(std::memory_order_relaxed)) {
+        Unmap();
+    }
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        HILOG_WARN(LOG_CORE, "failed to open spool file, errno=%{public}d", errno);
+        return false;
+    }
+    // the spool belongs to one process only
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        HILOG_WARN(LOG_CORE, "failed to lock spool file, errno=%{public}d", errno);
+        close(fd);
+        return false;
+    }
+    if (!Map(fd, std::clamp(capacity, MIN_SPOOL_CAPACITY, MAX_SPOOL_CAPACITY) & ~(RECORD_ALIGN - 1))) {
+        close(fd);
+        return false;
+    }
+    spooledCnt_ = 0;
+    drainedCnt_ = 0;
+    droppedCnt_ = 0;
+    tornCnt_ = 0;
+    Recover();
+    isOpened_.store(true, std::memory_order_release);
+    if (recoveredCnt_ > 0 || tornCnt_ > 0) {
+        HILOG_INFO(LOG_CORE, "%{public}" PRIu64 " events are left in spool file, %{public}" PRIu64 " torn",
+            recoveredCnt_, tornCnt_);
+    }
+    return true;
+}
+
+void EventSpool::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isOpened_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    (void)msync(header_, FILE_HEADER_SIZE + capacity_, MS_SYNC);
+    Unmap();
+}
+
+bool EventSpool::IsOpened() const
+{
+    return isOpened_.load(std::memory_order_acquire);
+}
+
+bool EventSpool::IsEmpty() const
+{
+    return pendingCnt_.load(std::memory_order_acquire) == 0;
+}
+
+bool EventSpool::Append(const RawData& rawData)
+{
+    if (!isOpened_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isOpened_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    auto len = static_cast<uint32_t>(rawData.GetDataLength());
+    uint32_t size = GetRecordSize(len);
+    if (usedBytes_ == 0) {
+        // all records are sent, the ring restarts from the beginning
+        readPos_ = 0;
+        writePos_ = 0;
+        StoreCursor();
+    }
+    uint32_t seq = readSeq_ + static_cast<uint32_t>(pendingCnt_.load(std::memory_order_relaxed));
+    if (usedBytes_ > 0 && writePos_ <= readPos_) {
+        if (size > readPos_ - writePos_) {
+            droppedCnt_++;
+            return false;
+        }
+    } else if (size > capacity_ - writePos_) {
+        if (size > readPos_) {
+            droppedCnt_++;
+            return false;
+        }
+        // the record never crosses the end of the ring, which is told by the mark if there is room for it
+        uint32_t tail = capacity_ - writePos_;
+        if (tail >= sizeof(RecordHeader)) {
+            RecordHeader mark = { WRAP_MARK, seq, GetChecksum(WRAP_MARK, seq, nullptr), 0 };
+            (void)memcpy_s(ring_ + writePos_, tail, &mark, sizeof(mark));
+        }
+        usedBytes_ += tail;
+        writePos_ = 0;
+    }
+    // the event is written before its header, so that a torn record is found by the checksum
+    (void)memcpy_s(ring_ + writePos_ + sizeof(RecordHeader), size - sizeof(RecordHeader), rawData.GetData(), len);
+    RecordHeader header = { len, seq, GetChecksum(len, seq, rawData.GetData()), 0 };
+    (void)memcpy_s(ring_ + writePos_, size, &header, sizeof(header));
+    writePos_ += size;
+    usedBytes_ += size;
+    spooledCnt_++;
+    pendingCnt_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool EventSpool::Front(RawData& rawData) const
+{
+    if (pendingCnt_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isOpened_.load(std::memory_order_relaxed) || pendingCnt_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    auto record = ring_ + SkipWrap(readPos_);
+    RecordHeader header;
+    (void)memcpy_s(&header, sizeof(header), record, sizeof(header));
+    rawData.Reset();
+    return rawData.Append(record + sizeof(RecordHeader), header.len);
+}
+
+void EventSpool::Pop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isOpened_.load(std::memory_order_relaxed) || pendingCnt_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    uint32_t pos = SkipWrap(readPos_);
+    usedBytes_ -= (pos == readPos_) ? 0 : (capacity_ - readPos_);
+    RecordHeader header;
+    (void)memcpy_s(&header, sizeof(header), ring_ + pos, sizeof(header));
+    uint32_t size = GetRecordSize(header.len);
+    readPos_ = pos + size;
+    readSeq_++;
+    drainedCnt_++;
+    // the room of the ring skipped by the mark left torn is freed along with the last record
+    usedBytes_ = (pendingCnt_.fetch_sub(1, std::memory_order_release) == 1) ? 0 : (usedBytes_ - size);
+    StoreCursor();
+}
+
+void EventSpool::GetStats(EventSpoolStats& stats) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.isOpened = isOpened_.load(std::memory_order_relaxed);
+    stats.capacity = capacity_;
+    stats.usedBytes = usedBytes_;
+    stats.pendingCnt = pendingCnt_.load(std::memory_order_relaxed);
+    stats.spooledCnt = spooledCnt_;
+    stats.drainedCnt = drainedCnt_;
+    stats.recoveredCnt = recoveredCnt_;
+    stats.droppedCnt = droppedCnt_;
+    stats.tornCnt = tornCnt_;
+}
+
+bool EventSpool::Map(int fd, uint32_t capacity)
+{
+    static_assert(sizeof(FileHeader) <= FILE_HEADER_SIZE, "header of spool file is too large");
+    size_t fileSize = FILE_HEADER_SIZE + capacity;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (static_cast<size_t>(st.st_size) != fileSize &&
+        ftruncate(fd, static_cast<off_t>(fileSize)) != 0)) {
+        HILOG_WARN(LOG_CORE, "failed to resize spool file, errno=%{public}d", errno);
+        return false;
+    }
+    void* addr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        HILOG_WARN(LOG_CORE, "failed to map spool file, errno=%{public}d", errno);
+        return false;
+    }
+    fd_ = fd;
+    header_ = static_cast<FileHeader*>(addr);
+    ring_ = static_cast<uint8_t*>(addr) + FILE_HEADER_SIZE;
+    capacity_ = capacity;
+    if (header_->magic != SPOOL_MAGIC || header_->version != SPOOL_VERSION || header_->capacity != capacity) {
+        // new file, or the one of another layout whose records can not be read
+        header_->cursor.store(INIT_CURSOR, std::memory_order_relaxed);
+        header_->capacity = capacity;
+        header_->version = SPOOL_VERSION;
+        header_->reserved = 0;
+        header_->magic = SPOOL_MAGIC;
+    }
+    return true;
+}
+
+void EventSpool::Unmap()
+{
+    if (header_ != nullptr) {
+        (void)munmap(header_, FILE_HEADER_SIZE + capacity_);
+    }
+    if (fd_ >= 0) {
+        close(fd_); // the file is unlocked once it is closed by all processes sharing it
+    }
+    fd_ = -1;
+    header_ = nullptr;
+    ring_ = nullptr;
+    capacity_ = 0;
+    readPos_ = 0;
+    readSeq_ = 0;
+    writePos_ = 0;
+    usedBytes_ = 0;
+    recoveredCnt_ = 0;
+    pendingCnt_.store(0, std::memory_order_relaxed);
+    isOpened_.store(false, std::memory_order_release);
+}
+
+void EventSpool::Recover()
+{
+    uint64_t cursor = header_->cursor.load(std::memory_order_acquire);
+    readPos_ = static_cast<uint32_t>(cursor);
+    readSeq_ = static_cast<uint32_t>(cursor >> 32); // 32: sequence is stored in the high bits
+    if (readPos_ > capacity_ || readPos_ % RECORD_ALIGN != 0) {
+        tornCnt_++;
+        readPos_ = 0;
+    }
+    // scan the records from the oldest one until the sequence breaks or a torn record is found
+    uint32_t pos = readPos_;
+    uint32_t seq = readSeq_;
+    uint32_t used = 0;
+    uint64_t cnt = 0;
+    while (used < capacity_) {
+        if (capacity_ - pos < sizeof(RecordHeader)) {
+            used += capacity_ - pos;
+            pos = 0;
+            continue;
+        }
+        RecordHeader header;
+        (void)memcpy_s(&header, sizeof(header), ring_ + pos, sizeof(header));
+        if (header.seq != seq) {
+            break;
+        }
+        if (header.len == WRAP_MARK) {
+            if (header.checksum != GetChecksum(WRAP_MARK, seq, nullptr)) {
+                tornCnt_++;
+                break;
+            }
+            used += capacity_ - pos;
+            pos = 0;
+            continue;
+        }
+        uint32_t size = GetRecordSize(header.len);
+        if (header.len == 0 || header.len > MAX_DATA_SIZE || size > capacity_ - pos || size > capacity_ - used ||
+            header.checksum != GetChecksum(header.len, seq, ring_ + pos + sizeof(RecordHeader))) {
+            tornCnt_++;
+            break;
+        }
+        pos += size;
+        used += size;
+        seq++;
+        cnt++;
+    }
+    writePos_ = pos;
+    usedBytes_ = (cnt == 0) ? 0 : used;
+    recoveredCnt_ = cnt;
+    pendingCnt_.store(cnt, std::memory_order_relaxed);
+    StoreCursor();
+}
+
+uint32_t EventSpool::SkipWrap(uint32_t pos) const
+{
+    if (capacity_ - pos < sizeof(RecordHeader)) {
+        return 0;
+    }
+    RecordHeader header;
+    (void)memcpy_s(&header, sizeof(header), ring_ + pos, sizeof(header));
+    return (header.len == WRAP_MARK) ? 0 : pos;
+}
+
+void EventSpool::StoreCursor()
+{
+    header_->cursor.store((static_cast<uint64_t>(readSeq_) << 32) | readPos_, // 32: sequence in the high bits
+        std::memory_order_release);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,16 +17,26 @@
 
 #include <cctype>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "async_sender.h"
+#include "circuit_breaker.h"
 #include "def.h"
+#include "event_aggregator.h"
+#include "event_buffer_cache.h"
+#include "event_sampler.h"
+#include "event_socket_factory.h"
+#include "event_spool.h"
 #include "hilog/log.h"
 #ifdef HIVIEWDFX_HITRACE_ENABLED
 #include "hitrace/trace.h"
 #endif
+#include "process_info_cache.h"
+#include "rate_limiter.h"
 #include "securec.h"
 #include "transport.h"
 
@@ -39,10 +49,15 @@
 namespace OHOS {
 namespace HiviewDFX {
 HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& eventName, int type,
-    uint64_t timeStamp)
+    uint64_t timeStamp) : EventBase(domain, eventName, type, timeStamp, false)
+{
+}
+
+HiSysEvent::EventBase::EventBase(const std::string& domain, const std::string& eventName, int type,
+    uint64_t timeStamp, bool isDomainChecked)
 {
     retCode_ = 0;
-    if (!StringFilter::GetInstance().IsValidName(domain, MAX_DOMAIN_LENGTH)) {
+    if (!isDomainChecked && !StringFilter::GetInstance().IsValidName(domain, MAX_DOMAIN_LENGTH)) {
         SetRetCode(ERR_DOMAIN_NAME_INVALID);
         return;
     }
@@ -82,21 +97,23 @@ void HiSysEvent::EventBase::AppendParam(std::shared_ptr<Encoded::EncodedParam> p
         return;
     }
     param->SetRawData(rawData_);
+    size_t begin = (rawData_ != nullptr) ? rawData_->GetDataLength() : 0;
     if (param->Encode()) {
         paramCnt_++;
+        ParamDigested(begin);
     }
 }
 
 void HiSysEvent::EventBase::WritebaseInfo()
 {
-    rawData_ = std::make_shared<RawData>();
+    rawData_ = EventBufferCache::Borrow();
     if (rawData_ == nullptr) {
         SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
-    header_.timeZone = static_cast<uint8_t>(ParseTimeZone(timezone));
-    header_.pid = static_cast<uint32_t>(getprocpid());
-    header_.tid = static_cast<uint32_t>(getproctid());
+    header_.timeZone = ProcessInfoCache::GetTimeZoneIndex();
+    header_.pid = ProcessInfoCache::GetPid();
+    header_.tid = ProcessInfoCache::GetTid();
     header_.uid = static_cast<uint32_t>(getuid());
 #ifdef HIVIEWDFX_HITRACE_ENABLED
     HiTraceId hitraceId = HiTraceChain::GetId();
@@ -132,6 +149,36 @@ void HiSysEvent::EventBase::WritebaseInfo()
         SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
+    if (paramDigest_ != nullptr) {
+        paramDigest_->Reset(rawData_->GetDataLength());
+    }
+}
+
+void HiSysEvent::EventBase::EnableParamDigest()
+{
+    // the digest is reused by the thread, so that no memory is allocated for the events folded
+    thread_local Encoded::ParamDigest digest;
+    paramDigest_ = &digest;
+}
+
+const Encoded::ParamDigest* HiSysEvent::EventBase::GetParamDigest() const
+{
+    return paramDigest_;
+}
+
+std::string_view HiSysEvent::EventBase::GetDomain() const
+{
+    return std::string_view(header_.domain, strnlen(header_.domain, sizeof(header_.domain)));
+}
+
+std::string_view HiSysEvent::EventBase::GetEventName() const
+{
+    return std::string_view(header_.name, strnlen(header_.name, sizeof(header_.name)));
+}
+
+int HiSysEvent::EventBase::GetEventType() const
+{
+    return static_cast<int>(header_.type) + 1; // header stores type - 1
 }
 
 size_t HiSysEvent::EventBase::GetParamCnt()
@@ -160,7 +207,12 @@ int HiSysEvent::CheckKey(const std::string& key)
 
 int HiSysEvent::CheckValue(const std::string& value)
 {
-    if (value.length() > MAX_STRING_LENGTH) {
+    return CheckValueLength(value.length());
+}
+
+int HiSysEvent::CheckValueLength(const size_t length)
+{
+    if (length > MAX_STRING_LENGTH) {
         return ERR_VALUE_LENGTH_TOO_LONG;
     }
     return SUCCESS;
@@ -219,6 +271,11 @@ bool HiSysEvent::UpdateAndCheckKeyNumIsOver(EventBase& eventBase)
 }
 
 void HiSysEvent::SendSysEvent(EventBase& eventBase)
+{
+    SendSysEvent(eventBase, 0); // 0: call site is unknown
+}
+
+void HiSysEvent::SendSysEvent(EventBase& eventBase, uint64_t callSite)
 {
     auto rawData = eventBase.GetEventRawData();
     if (rawData == nullptr) {
@@ -226,16 +283,162 @@ void HiSysEvent::SendSysEvent(EventBase& eventBase)
         (void)ExplainThenReturnRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
         return;
     }
-    int r = Transport::GetInstance().SendData(*(eventBase.GetEventRawData()));
+    auto& limiter = RateLimiter::GetInstance();
+    if (limiter.IsEnabled() && !limiter.IsWriteAllowed(*rawData, callSite)) {
+        eventBase.SetRetCode(ERR_WRITE_IN_HIGH_FREQ);
+        (void)ExplainThenReturnRetCode(ERR_WRITE_IN_HIGH_FREQ);
+        return;
+    }
+    // the route is decided once by the domain, name and type known here instead of the header encoded
+    auto route = EventSocketFactory::GetEventRoute(eventBase.GetDomain(), eventBase.GetEventName(),
+        eventBase.GetEventType());
+    int r = AsyncSender::IsEnabled() ? AsyncSender::Submit(*rawData, route) :
+        Transport::GetInstance().SendData(*rawData, route);
     if (r != SUCCESS) {
         eventBase.SetRetCode(r);
         (void)ExplainThenReturnRetCode(r);
     }
 }
 
+bool HiSysEvent::IsCallSiteRateLimited()
+{
+    return RateLimiter::GetInstance().IsCallSiteLimited();
+}
+
+bool HiSysEvent::IsStatisticAggregated()
+{
+    return EventAggregator::GetInstance().IsEnabled();
+}
+
+void HiSysEvent::AggregateSysEvent(EventBase& eventBase, uint64_t callSite)
+{
+    auto rawData = eventBase.GetEventRawData();
+    auto paramDigest = eventBase.GetParamDigest();
+    if (rawData == nullptr || paramDigest == nullptr) {
+        eventBase.SetRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
+        (void)ExplainThenReturnRetCode(ERR_RAW_DATA_WROTE_EXCEPTION);
+        return;
+    }
+    switch (EventAggregator::GetInstance().Aggregate(*rawData, *paramDigest, callSite)) {
+        case AggregateResult::FOLDED:
+            return;
+        case AggregateResult::DISCARDED:
+            eventBase.SetRetCode(ERR_WRITE_IN_HIGH_FREQ);
+            (void)ExplainThenReturnRetCode(ERR_WRITE_IN_HIGH_FREQ);
+            return;
+        default:
+            SendSysEvent(eventBase, callSite);
+            return;
+    }
+}
+
+bool HiSysEvent::IsSampledOut(std::string_view domain, std::string_view eventName, uint32_t& samplingRate)
+{
+    return !EventSampler::IsSampledIn(domain, eventName, samplingRate);
+}
+
+bool HiSysEvent::AppendSamplingRate(EventBase& eventBase, uint32_t samplingRate)
+{
+    // the event kept without the rate would be weighted wrongly by the consumers, so it is discarded instead
+    if (eventBase.GetParamCnt() >= MAX_PARAM_NUMBER) {
+        HILOG_WARN(LOG_CORE, "no room for %{public}s of the event sampled, discard it",
+            EventSampler::SAMPLING_RATE_KEY);
+        eventBase.SetRetCode(ERR_KEY_NUMBER_TOO_MUCH);
+        return false;
+    }
+    eventBase.AppendParam<double>(EventSampler::SAMPLING_RATE_KEY,
+        static_cast<double>(samplingRate) / FULL_SAMPLING_RATE);
+    return true;
+}
+
+void HiSysEvent::SetBatchMode(bool enabled, uint32_t batchSize, uint32_t latencyBudget)
+{
+    Transport::GetInstance().SetBatchMode(enabled, batchSize, latencyBudget);
+}
+
+int HiSysEvent::Flush()
+{
+    return Transport::GetInstance().Flush();
+}
+
+void HiSysEvent::SetAsyncMode(bool enabled, uint32_t queueDepth, AsyncDropPolicy policy)
+{
+    AsyncSender::SetEnabled(enabled, queueDepth, policy);
+}
+
+uint64_t HiSysEvent::GetAsyncDroppedCount()
+{
+    return AsyncSender::GetDroppedCount();
+}
+
+bool HiSysEvent::SetAsyncPriorityLanes(const std::vector<PriorityLaneConfig>& lanes)
+{
+    return AsyncSender::SetPriorityLanes(lanes);
+}
+
+bool HiSysEvent::GetAsyncPriorityLaneStats(uint32_t lane, PriorityLaneStats& stats)
+{
+    return AsyncSender::GetPriorityLaneStats(lane, stats);
+}
+
+void HiSysEvent::SetCircuitBreaker(bool enabled, uint32_t failureThreshold, uint32_t maxBackoff)
+{
+    CircuitBreaker::GetInstance().SetParams(enabled, failureThreshold, maxBackoff);
+}
+
+void HiSysEvent::GetCircuitBreakerStats(CircuitBreakerStats& stats)
+{
+    CircuitBreaker::GetInstance().GetStats(stats);
+}
+
+bool HiSysEvent::SetEventSpool(bool enabled, const std::string& path, uint32_t capacity)
+{
+    return Transport::GetInstance().SetSpool(enabled, path, capacity);
+}
+
+void HiSysEvent::GetEventSpoolStats(EventSpoolStats& stats)
+{
+    EventSpool::GetInstance().GetStats(stats);
+}
+
+void HiSysEvent::SetStatisticAggregation(bool enabled, uint32_t window)
+{
+    EventAggregator::GetInstance().SetParams(enabled, window);
+}
+
+void HiSysEvent::GetStatisticAggregationStats(AggregationStats& stats)
+{
+    EventAggregator::GetInstance().GetStats(stats);
+}
+
+bool HiSysEvent::SetRateLimit(const std::string& configPath)
+{
+    return RateLimiter::GetInstance().LoadConfig(configPath);
+}
+
+void HiSysEvent::GetRateLimitStats(RateLimitStats& stats)
+{
+    RateLimiter::GetInstance().GetStats(stats);
+}
+
+bool HiSysEvent::SetSamplingPolicies(const std::vector<SamplingPolicy>& policies)
+{
+    return EventSampler::SetPolicies(policies);
+}
+
+bool HiSysEvent::GetSamplingStats(uint32_t policy, SamplingStats& stats)
+{
+    return EventSampler::GetStats(policy, stats);
+}
+
+void HiSysEvent::SetPackedArrayMode(bool enabled)
+{
+    Encoded::RawDataEncoder::SetPackedArrayEnabled(enabled);
+}
+
 void HiSysEvent::AppendHexData(EventBase& eventBase, const std::string& key, uint64_t value)
 {
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key, value));
+    eventBase.AppendParam(key, value);
 }
 
 void HiSysEvent::WritebaseInfo(EventBase& eventBase)
@@ -253,7 +456,7 @@ void HiSysEvent::AppendBoolParam(EventBase& eventBase, const HiSysEventParam& pa
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<bool>>(param.name, param.v.b));
+    eventBase.AppendParam<bool>(param.name, param.v.b);
 }
 
 void HiSysEvent::AppendInt8Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -261,7 +464,7 @@ void HiSysEvent::AppendInt8Param(EventBase& eventBase, const HiSysEventParam& pa
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int8_t>>(param.name, param.v.i8));
+    eventBase.AppendParam<int8_t>(param.name, param.v.i8);
 }
 
 void HiSysEvent::AppendUint8Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -269,7 +472,7 @@ void HiSysEvent::AppendUint8Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint8_t>>(param.name, param.v.ui8));
+    eventBase.AppendParam<uint8_t>(param.name, param.v.ui8);
 }
 
 void HiSysEvent::AppendInt16Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -277,7 +480,7 @@ void HiSysEvent::AppendInt16Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int16_t>>(param.name, param.v.i16));
+    eventBase.AppendParam<int16_t>(param.name, param.v.i16);
 }
 
 void HiSysEvent::AppendUint16Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -285,7 +488,7 @@ void HiSysEvent::AppendUint16Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint16_t>>(param.name, param.v.ui16));
+    eventBase.AppendParam<uint16_t>(param.name, param.v.ui16);
 }
 
 void HiSysEvent::AppendInt32Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -293,7 +496,7 @@ void HiSysEvent::AppendInt32Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int32_t>>(param.name, param.v.i32));
+    eventBase.AppendParam<int32_t>(param.name, param.v.i32);
 }
 
 void HiSysEvent::AppendUint32Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -301,7 +504,7 @@ void HiSysEvent::AppendUint32Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint32_t>>(param.name, param.v.ui32));
+    eventBase.AppendParam<uint32_t>(param.name, param.v.ui32);
 }
 
 void HiSysEvent::AppendInt64Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -309,7 +512,7 @@ void HiSysEvent::AppendInt64Param(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(param.name, param.v.i64));
+    eventBase.AppendParam<int64_t>(param.name, param.v.i64);
 }
 
 void HiSysEvent::AppendUint64Param(EventBase& eventBase, const HiSysEventParam& param)
@@ -317,7 +520,7 @@ void HiSysEvent::AppendUint64Param(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(param.name, param.v.ui64));
+    eventBase.AppendParam<uint64_t>(param.name, param.v.ui64);
 }
 
 void HiSysEvent::AppendFloatParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -325,7 +528,7 @@ void HiSysEvent::AppendFloatParam(EventBase& eventBase, const HiSysEventParam& p
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<float>>(param.name, param.v.f));
+    eventBase.AppendParam<float>(param.name, param.v.f);
 }
 
 void HiSysEvent::AppendDoubleParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -333,7 +536,7 @@ void HiSysEvent::AppendDoubleParam(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<double>>(param.name, param.v.d));
+    eventBase.AppendParam<double>(param.name, param.v.d);
 }
 
 void HiSysEvent::AppendStringParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -345,9 +548,9 @@ void HiSysEvent::AppendStringParam(EventBase& eventBase, const HiSysEventParam&
     if (!CheckParamValidity(eventBase, param.name)) {
         return;
     }
-    IsWarnAndUpdate(CheckValue(std::string(param.v.s)), eventBase);
-    auto rawStr = StringFilter::GetInstance().EscapeToRaw(std::string(param.v.s));
-    eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(param.name, rawStr));
+    size_t len = strlen(param.v.s);
+    IsWarnAndUpdate(CheckValueLength(len), eventBase);
+    eventBase.AppendParam(param.name, Encoded::EscapedString { param.v.s, len });
 }
 
 void HiSysEvent::AppendBoolArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -356,11 +559,7 @@ void HiSysEvent::AppendBoolArrayParam(EventBase& eventBase, const HiSysEventPara
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<bool> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendInt8ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -369,11 +568,7 @@ void HiSysEvent::AppendInt8ArrayParam(EventBase& eventBase, const HiSysEventPara
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int8_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int8_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendUint8ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -382,11 +577,7 @@ void HiSysEvent::AppendUint8ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint8_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint8_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendInt16ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -395,11 +586,7 @@ void HiSysEvent::AppendInt16ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int16_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int16_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendUint16ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -408,11 +595,7 @@ void HiSysEvent::AppendUint16ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint16_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint16_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendInt32ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -421,11 +604,7 @@ void HiSysEvent::AppendInt32ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int32_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int32_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendUint32ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -434,11 +613,7 @@ void HiSysEvent::AppendUint32ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint32_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint32_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendInt64ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -447,11 +622,7 @@ void HiSysEvent::AppendInt64ArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<int64_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendUint64ArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -460,11 +631,7 @@ void HiSysEvent::AppendUint64ArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<uint64_t> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendFloatArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -473,11 +640,7 @@ void HiSysEvent::AppendFloatArrayParam(EventBase& eventBase, const HiSysEventPar
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<float> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<float>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendDoubleArrayParam(EventBase& eventBase, const HiSysEventParam& param)
@@ -486,36 +649,16 @@ void HiSysEvent::AppendDoubleArrayParam(EventBase& eventBase, const HiSysEventPa
     if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<double> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
-        return;
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<double>>(param.name, value));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::AppendStringArrayParam(EventBase& eventBase, const HiSysEventParam& param)
 {
     auto array = reinterpret_cast<char**>(param.v.array);
-    if (array == nullptr) {
-        eventBase.SetRetCode(ERR_VALUE_INVALID);
-        return;
-    }
-    for (size_t i = 0; i < param.arraySize; ++i) {
-        if (auto temp = array + i; *temp == nullptr) {
-            eventBase.SetRetCode(ERR_VALUE_INVALID);
-            return;
-        }
-    }
-    std::vector<std::string> value(array, array + param.arraySize);
-    if (!CheckArrayParamsValidity(eventBase, param.name, value)) {
+    if (!CheckArrayValidity(eventBase, array)) {
         return;
     }
-    std::vector<std::string> rawStrs;
-    for (auto& item : value) {
-        IsWarnAndUpdate(CheckValue(item), eventBase);
-        rawStrs.emplace_back(StringFilter::GetInstance().EscapeToRaw(item));
-    }
-    eventBase.AppendParam(std::make_shared<Encoded::StringEncodedArrayParam>(param.name, rawStrs));
+    AppendArrayParam(eventBase, param.name, array, param.arraySize);
 }
 
 void HiSysEvent::InnerWrite(EventBase& eventBase)
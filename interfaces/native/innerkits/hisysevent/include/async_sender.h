@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_ASYNC_SENDER_H
+#define HISYSEVENT_ASYNC_SENDER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "event_socket_factory.h"
+#include "raw_data.h"
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class AsyncSender {
+public:
+    /*
+     * Events submitted are copied into a lock-free bounded queue and sent by a background thread, the
+     * depth of queue is fixed once the async mode is enabled at the first time. Lanes set before are merged
+     * into the first one once the async mode is enabled.
+     */
+    static void SetEnabled(bool enabled, uint32_t queueDepth, AsyncDropPolicy policy);
+    static bool IsEnabled();
+    static int Submit(Encoded::RawData& rawData, const EventRoute& route);
+    static uint64_t GetDroppedCount();
+
+    /*
+     * Split the queue into lanes, each of which has its own queue, drop policy and background thread with its
+     * own sockets, so that events of a lane are never delayed by the ones of lanes behind it. Events are sent
+     * by the first lane matching them, and the ones matched by no lane are sent by the last lane. The depth of
+     * each lane is fixed once the lane is created, and the async mode is enabled by the lanes set.
+     */
+    static bool SetPriorityLanes(const std::vector<PriorityLaneConfig>& lanes);
+    static uint32_t GetPriorityLaneCount();
+    static bool GetPriorityLaneStats(uint32_t lane, PriorityLaneStats& stats);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_ASYNC_SENDER_H
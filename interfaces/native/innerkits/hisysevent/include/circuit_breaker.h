@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_CIRCUIT_BREAKER_H
+#define HISYSEVENT_CIRCUIT_BREAKER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr uint32_t MIN_CIRCUIT_BACKOFF = 100; // 100ms
+
+/*
+ * Process-wide breaker of sending events, which is opened by sustained failures of sending, so that the writing
+ * threads stop trying to send while hiview is unavailable. Once opened, an event is sent to probe after the
+ * backoff, which is doubled by each failed probe, and the breaker is closed once an event is sent successfully.
+ */
+class CircuitBreaker {
+public:
+    static CircuitBreaker& GetInstance();
+    void SetParams(bool enabled, uint32_t failureThreshold, uint32_t maxBackoff);
+
+    // the caller who is allowed to send while the breaker is not closed is the one to probe
+    bool IsSendAllowed();
+    void OnSendSucceeded();
+    void OnSendFailed();
+    void OnFastFailed();
+
+    bool IsClosed() const;
+    uint64_t GetProbeDelay() const; // milliseconds to the next probe, 0 if the breaker is closed
+    void GetStats(CircuitBreakerStats& stats) const;
+
+private:
+    CircuitBreaker() = default;
+    ~CircuitBreaker() = default;
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    // should be called with mutex_ locked
+    void Transit(CircuitState state, uint64_t now);
+
+private:
+    std::atomic<bool> isEnabled_ { true };
+    std::atomic<CircuitState> state_ { CircuitState::CLOSED };
+    std::atomic<uint32_t> consecutiveFailures_ { 0 };
+    std::atomic<uint64_t> fastFailedCnt_ { 0 };
+    mutable std::mutex mutex_;
+    uint32_t failureThreshold_ = DEFAULT_CIRCUIT_FAILURE_THRESHOLD;
+    uint32_t maxBackoff_ = DEFAULT_CIRCUIT_MAX_BACKOFF;
+    uint32_t backoff_ = MIN_CIRCUIT_BACKOFF;
+    uint64_t nextProbeTime_ = 0;
+    uint64_t openedCnt_ = 0;
+    uint64_t closedCnt_ = 0;
+    uint64_t probeCnt_ = 0;
+    uint64_t lastTransitionTime_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_CIRCUIT_BREAKER_H
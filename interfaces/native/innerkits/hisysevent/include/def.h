@@ -61,6 +61,9 @@ static constexpr unsigned int MAX_ARRAY_SIZE = 100;
 static constexpr unsigned int MAX_PARAM_NUMBER = 128;
 static constexpr unsigned int MAX_STRING_LENGTH = 256 * 1024;
 static constexpr unsigned int MAX_DATA_SIZE = 384 * 1024;
+static constexpr unsigned int DEFAULT_BATCH_SIZE = 16;
+static constexpr unsigned int MAX_BATCH_SIZE = 64;
+static constexpr unsigned int DEFAULT_BATCH_LATENCY_BUDGET = 100; // 100ms
 } // namespace HiviewDFX
 } // namespace OHOS
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,11 +16,14 @@
 #ifndef HISYSEVENT_INTERFACE_ENCODE_INCLUDE_ENCODED_PARAM_H
 #define HISYSEVENT_INTERFACE_ENCODE_INCLUDE_ENCODED_PARAM_H
 
+#include <array>
+#include <cmath>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "raw_data_base_def.h"
@@ -30,6 +33,208 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace Encoded {
+/*
+ * Encode key, value type and value of a parameter straight into the raw data of an event,
+ * with no intermediate objects. The output is the same as the one of EncodedParam below.
+ */
+class ParamEncoder {
+public:
+    template<typename T>
+    static constexpr ValueType GetValueType()
+    {
+        auto valueType = ValueType::STRING;
+        if constexpr (isUnsignedNum<T>) {
+            valueType = ValueType::UINT64;
+        } else if constexpr (isSignedNum<T>) {
+            valueType = ValueType::INT64;
+        } else if constexpr (std::is_same_v<std::decay_t<T>, float>) {
+            valueType = ValueType::FLOAT;
+        } else if constexpr (std::is_same_v<std::decay_t<T>, double>) {
+            valueType = ValueType::DOUBLE;
+        }
+        return valueType;
+    }
+
+    template<typename T>
+    static constexpr uint8_t GetPackedByteCnt()
+    {
+        return std::is_same_v<std::decay_t<T>, float> ? PACKED_FLOAT_BYTE_CNT : PACKED_DOUBLE_BYTE_CNT;
+    }
+
+    template<typename T>
+    static bool ValueTypeEncoded(RawData& data, bool isArray)
+    {
+        return RawDataEncoder::ValueTypeEncoded(data, isArray, GetValueType<T>(), 0);
+    }
+
+    template<typename T>
+    static bool PackedArrayValueTypeEncoded(RawData& data)
+    {
+        return RawDataEncoder::ValueTypeEncoded(data, true, GetValueType<T>(), GetPackedByteCnt<T>());
+    }
+
+    // key and value type of a parameter encoded at compile time, same as the ones encoded by ParamEncoded
+    template<typename T, bool isArray, size_t keyLen>
+    static constexpr auto ConstKeyEncoded(std::string_view key)
+    {
+        constexpr size_t encodedSize = RawDataEncoder::GetUnsignedVarintEncodedSize(keyLen) + keyLen + 1;
+        std::array<uint8_t, encodedSize> encoded {};
+        size_t pos = RawDataEncoder::ConstUnsignedVarintEncoded(encoded.data(), EncodeType::LENGTH_DELIMITED, keyLen);
+        for (size_t i = 0; i < keyLen; ++i) {
+            encoded[pos++] = static_cast<uint8_t>(key[i]);
+        }
+        encoded[pos] = RawDataEncoder::ConstValueTypeEncoded(isArray, GetValueType<T>(), 0);
+        return encoded;
+    }
+
+    template<typename T>
+    static bool ValueEncoded(RawData& data, const T& val)
+    {
+        if constexpr (isUnsignedNum<T>) {
+            return RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::VARINT, val);
+        } else if constexpr (isSignedNum<T>) {
+            return RawDataEncoder::SignedVarintEncoded(data, EncodeType::VARINT, val);
+        } else if constexpr (isFloatingNum<T>) {
+            return RawDataEncoder::FloatingNumberEncoded(data, std::isfinite(val) ? val : static_cast<T>(0));
+        } else if constexpr (std::is_same_v<std::decay_t<T>, EscapedString>) {
+            return RawDataEncoder::EscapedStringValueEncoded(data, val);
+        } else {
+            return RawDataEncoder::StringValueEncoded(data, val);
+        }
+    }
+
+    // only the first MAX_ARRAY_SIZE items will be encoded, each item is converted to T by convertor
+    template<typename T, typename Iter, typename Convertor>
+    static bool ArrayValueEncoded(RawData& data, Iter begin, size_t size, Convertor convertor)
+    {
+        size_t cnt = (size > MAX_ARRAY_SIZE) ? MAX_ARRAY_SIZE : size;
+        if (!RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, cnt)) {
+            return false;
+        }
+        for (size_t index = 0; index < cnt; ++index, ++begin) {
+            if (!ValueEncoded<T>(data, convertor(*begin))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename T, typename Iter>
+    static bool ArrayValueEncoded(RawData& data, Iter begin, size_t size)
+    {
+        if constexpr (isUnsignedNum<T> || isSignedNum<T>) {
+            size_t cnt = (size > MAX_ARRAY_SIZE) ? MAX_ARRAY_SIZE : size;
+            return RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, cnt) &&
+                RawDataEncoder::VarintArrayEncoded<T>(data, EncodeType::VARINT, begin, cnt);
+        } else {
+            return ArrayValueEncoded<T>(data, begin, size, [] (const auto& item) {
+                return static_cast<T>(item);
+            });
+        }
+    }
+
+    // only the first MAX_ARRAY_SIZE items of float or double array will be packed
+    template<typename T, typename Iter>
+    static bool PackedArrayValueEncoded(RawData& data, Iter begin, size_t size)
+    {
+        size_t cnt = (size > MAX_ARRAY_SIZE) ? MAX_ARRAY_SIZE : size;
+        return RawDataEncoder::PackedFloatingArrayEncoded<T>(data, begin, cnt);
+    }
+
+    template<typename T>
+    static bool ParamEncoded(RawData& data, const std::string& key, const T& val)
+    {
+        return RawDataEncoder::StringValueEncoded(data, key) && ValueTypeEncoded<T>(data, false) &&
+            ValueEncoded<T>(data, val);
+    }
+
+    template<typename T, typename Iter, typename... Convertor>
+    static bool ArrayParamEncoded(RawData& data, const std::string& key, Iter begin, size_t size,
+        Convertor... convertor)
+    {
+        if constexpr (isFloatingNum<T> && sizeof...(Convertor) == 0) {
+            if (RawDataEncoder::IsPackedArrayEnabled()) {
+                return RawDataEncoder::StringValueEncoded(data, key) && PackedArrayValueTypeEncoded<T>(data) &&
+                    PackedArrayValueEncoded<T>(data, begin, size);
+            }
+        }
+        return RawDataEncoder::StringValueEncoded(data, key) && ValueTypeEncoded<T>(data, true) &&
+            ArrayValueEncoded<T>(data, begin, size, convertor...);
+    }
+};
+
+/*
+ * Offsets of the parameters encoded into the raw data of an event and the values of the numeric ones,
+ * which are taken while the parameters are encoded, so that the event can be grouped without being decoded.
+ */
+class ParamDigest {
+public:
+    union NumericValue {
+        uint64_t uint64Value;
+        int64_t int64Value;
+        double floatingValue;
+    };
+
+    struct Param {
+        size_t begin = 0;       // offset of the key of the parameter
+        size_t valueBegin = 0;  // offset of the value, which follows the key and the value type
+        size_t end = 0;
+        size_t keyLen = 0;
+        ValueType valueType = ValueType::UNKNOWN; // UNKNOWN for the parameters not numeric
+        NumericValue value = { 0 };
+    };
+
+public:
+    void Reset(size_t paramsBegin)
+    {
+        paramsBegin_ = paramsBegin;
+        params_.clear();
+    }
+
+    size_t GetParamsBegin() const
+    {
+        return paramsBegin_;
+    }
+
+    const std::vector<Param>& GetParams() const
+    {
+        return params_;
+    }
+
+    void ParamAppended(size_t begin, size_t end)
+    {
+        Param param;
+        param.begin = begin;
+        param.valueBegin = end;
+        param.end = end;
+        params_.push_back(param);
+    }
+
+    // values of bool and intx_t are taken as int64_t, which are the same as the ones encoded
+    template<typename T>
+    void NumericParamAppended(size_t begin, size_t keyLen, size_t end, T value)
+    {
+        Param param;
+        param.begin = begin;
+        param.valueBegin = begin + RawDataEncoder::GetUnsignedVarintEncodedSize(keyLen) + keyLen + 1; // 1: value type
+        param.end = end;
+        param.keyLen = keyLen;
+        param.valueType = ParamEncoder::GetValueType<T>();
+        if constexpr (isUnsignedNum<T>) {
+            param.value.uint64Value = value;
+        } else if constexpr (isSignedNum<T>) {
+            param.value.int64Value = static_cast<int64_t>(value);
+        } else {
+            param.value.floatingValue = std::isfinite(value) ? static_cast<double>(value) : 0;
+        }
+        params_.push_back(param);
+    }
+
+private:
+    size_t paramsBegin_ = 0;
+    std::vector<Param> params_;
+};
+
 class EncodedParam {
 public:
     EncodedParam(const std::string& key);
@@ -67,7 +272,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, false, ValueType::UINT64, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, false);
     }
 
     virtual bool EncodeValue() override
@@ -75,7 +280,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::VARINT, val_);
+        return ParamEncoder::ValueEncoded<T>(*rawData_, val_);
     }
 
 private:
@@ -104,7 +309,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, true, ValueType::UINT64, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, true);
     }
 
     virtual bool EncodeValue() override
@@ -112,11 +317,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::VARINT, item);
-        }
-        return ret;
+        return ParamEncoder::ArrayValueEncoded<T>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
@@ -139,7 +340,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, false, ValueType::INT64, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, false);
     }
 
     virtual bool EncodeValue() override
@@ -147,7 +348,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::SignedVarintEncoded(*rawData_, EncodeType::VARINT, val_);
+        return ParamEncoder::ValueEncoded<T>(*rawData_, val_);
     }
 
 private:
@@ -177,7 +378,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, true, ValueType::INT64, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, true);
     }
 
     virtual bool EncodeValue() override
@@ -185,11 +386,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::SignedVarintEncoded(*rawData_, EncodeType::VARINT, item);
-        }
-        return ret;
+        return ParamEncoder::ArrayValueEncoded<T>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
@@ -210,14 +407,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        auto valueType = ValueType::UNKNOWN;
-        if (std::is_same_v<std::decay_t<T>, float>) {
-            valueType = ValueType::FLOAT;
-        }
-        if (std::is_same_v<std::decay_t<T>, double>) {
-            valueType = ValueType::DOUBLE;
-        }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, false, valueType, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, false);
     }
 
     virtual bool EncodeValue() override
@@ -225,7 +415,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::FloatingNumberEncoded(*rawData_, val_);
+        return ParamEncoder::ValueEncoded<T>(*rawData_, val_);
     }
 
 private:
@@ -257,14 +447,12 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        auto valueType = ValueType::UNKNOWN;
-        if (std::is_same_v<std::decay_t<T>, float>) {
-            valueType = ValueType::FLOAT;
+        // value is encoded in the same way as the value type even if packed array is switched in between
+        isPacked_ = RawDataEncoder::IsPackedArrayEnabled();
+        if (isPacked_) {
+            return ParamEncoder::PackedArrayValueTypeEncoded<T>(*rawData_);
         }
-        if (std::is_same_v<std::decay_t<T>, double>) {
-            valueType = ValueType::DOUBLE;
-        }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, true, valueType, 0);
+        return ParamEncoder::ValueTypeEncoded<T>(*rawData_, true);
     }
 
     virtual bool EncodeValue() override
@@ -272,15 +460,15 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::FloatingNumberEncoded(*rawData_, item);
+        if (isPacked_) {
+            return ParamEncoder::PackedArrayValueEncoded<T>(*rawData_, vals_.begin(), vals_.size());
         }
-        return ret;
+        return ParamEncoder::ArrayValueEncoded<T>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
     std::vector<T> vals_;
+    bool isPacked_ = false;
 };
 
 class StringEncodedParam : public EncodedParam {
@@ -295,7 +483,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, false, ValueType::STRING, 0);
+        return ParamEncoder::ValueTypeEncoded<std::string>(*rawData_, false);
     }
 
     virtual bool EncodeValue() override
@@ -303,7 +491,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::StringValueEncoded(*rawData_, val_);
+        return ParamEncoder::ValueEncoded<std::string>(*rawData_, val_);
     }
 
 private:
@@ -329,7 +517,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        return RawDataEncoder::ValueTypeEncoded(*rawData_, true, ValueType::STRING, 0);
+        return ParamEncoder::ValueTypeEncoded<std::string>(*rawData_, true);
     }
 
     virtual bool EncodeValue() override
@@ -337,11 +525,7 @@ public:
         if (rawData_ == nullptr) {
             return false;
         }
-        bool ret = RawDataEncoder::UnsignedVarintEncoded(*rawData_, EncodeType::LENGTH_DELIMITED, vals_.size());
-        for (auto item : vals_) {
-            ret = ret && RawDataEncoder::StringValueEncoded(*rawData_, item);
-        }
-        return ret;
+        return ParamEncoder::ArrayValueEncoded<std::string>(*rawData_, vals_.begin(), vals_.size());
     }
 
 private:
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_AGGREGATOR_H
+#define HISYSEVENT_EVENT_AGGREGATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <semaphore.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "encoded_param.h"
+#include "raw_data.h"
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr uint32_t MAX_AGGREGATION_GROUP_CNT = 256;
+
+enum class AggregateResult {
+    TO_SEND = 0,    // the event is the first one of its group in the window, which should be sent as usual
+    FOLDED = 1,     // the event is folded into the summary of its group
+    DISCARDED = 2,  // the event is discarded since there are too many groups in the window
+};
+
+/*
+ * Aggregator of STATISTIC events written repeatedly, events of the same domain, name and call site with the
+ * same keys and non numeric values belong to one group. The first event of a group is sent at once, and the
+ * following ones during the window are folded into one summary sent once the window ends, which has the non
+ * numeric parameters of the group, the sum, min and max of each numeric parameter, and the count of events folded.
+ * Sum, min and max are kept in 64 bits, so they are encoded as INT64, UINT64 or DOUBLE whatever the type of the
+ * parameter folded is, eg. the sum of INT8 parameters never wraps around at 128.
+ */
+class EventAggregator {
+public:
+    static constexpr char FOLDED_CNT_KEY[] = "AGGR_CNT";
+    static constexpr char MIN_KEY_SUFFIX[] = "_MIN";
+    static constexpr char MAX_KEY_SUFFIX[] = "_MAX";
+
+public:
+    static EventAggregator& GetInstance();
+
+    // the summaries of all groups are sent before the aggregator is disabled
+    void SetParams(bool enabled, uint32_t window);
+    bool IsEnabled() const;
+    // the event is grouped by the digest of its parameters taken while they are encoded
+    AggregateResult Aggregate(const Encoded::RawData& rawData, const Encoded::ParamDigest& paramDigest,
+        uint64_t callSite);
+    void GetStats(AggregationStats& stats) const;
+
+private:
+    EventAggregator();
+    ~EventAggregator() = default;
+    EventAggregator(const EventAggregator&) = delete;
+    EventAggregator& operator=(const EventAggregator&) = delete;
+
+private:
+    using NumericValue = Encoded::ParamDigest::NumericValue;
+
+    struct NumericStat {
+        uint8_t valueType;
+        NumericValue sum;
+        NumericValue min;
+        NumericValue max;
+    };
+
+    struct Group {
+        uint64_t windowEnd = 0;
+        uint64_t foldedCnt = 0;
+        Encoded::RawData firstEvent; // non numeric parameters of which are same as the ones of the group
+        size_t paramsBegin = 0;
+        std::vector<Encoded::ParamDigest::Param> params; // parameters of the first event
+        std::vector<NumericStat> stats;
+    };
+
+private:
+    // should be called with mutex_ locked
+    void Fold(Group& group, const Encoded::ParamDigest& paramDigest);
+    uint64_t TakeExpiredGroups(bool isAll, std::vector<Group>& expiredGroups);
+
+    // send summaries of the groups whose windows end, the end of the next window is returned
+    uint64_t SendSummaries(bool isAll);
+    bool StartTimer();
+    void SendSummariesInBackground();
+
+    static bool SummaryEncoded(const Group& group, Encoded::RawData& summary);
+    static void* SendInBackground(void* arg);
+
+private:
+    std::atomic<bool> isEnabled_ { false };
+    std::atomic<uint32_t> window_ { DEFAULT_AGGREGATION_WINDOW };
+    std::atomic<bool> isTimerStarted_ { false };
+    mutable std::mutex mutex_;
+    // groups are identified by the whole key instead of its hash, so that events of different groups are never
+    // folded together
+    std::unordered_map<std::string, Group> groups_;
+    sem_t wakeUpSem_;
+    AggregationStats stats_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_AGGREGATOR_H
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_BUFFER_CACHE_H
+#define HISYSEVENT_EVENT_BUFFER_CACHE_H
+
+#include <memory>
+
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+class EventBufferCache {
+public:
+    /*
+     * Borrow the buffer cached by the calling thread, which keeps its capacity between events so
+     * that steady-state writing needs no heap allocation. A new buffer will be created if the cached
+     * one is still being used or the cache has been disabled.
+     */
+    static std::shared_ptr<RawData> Borrow();
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_BUFFER_CACHE_H
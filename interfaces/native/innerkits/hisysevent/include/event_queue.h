@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_QUEUE_H
+#define HISYSEVENT_EVENT_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include "event_socket_factory.h"
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+using namespace Encoded;
+// bounded lock-free queue, each slot is owned by the one who has claimed it by its sequence
+class EventQueue {
+public:
+    explicit EventQueue(uint32_t depth);
+    ~EventQueue() = default;
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+public:
+    enum class PushResult {
+        PUSHED = 0,
+        FULL = 1,           // no slot is free
+        COPY_FAILED = 2,    // the slot claimed is released empty since the event fails to be copied into it
+    };
+
+public:
+    // the route is kept along with the event if it has been decided, so that it is not decided again while popped
+    PushResult Push(RawData& rawData, const EventRoute& route = {});
+    bool IsEmpty() const;
+    uint32_t GetSize() const;
+    void Reset();
+
+    template<typename F>
+    bool Pop(F handler)
+    {
+        auto pos = popPos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[pos % depth_];
+            auto diff = static_cast<int64_t>(slot->seq.load(std::memory_order_acquire) - (pos + 1));
+            if (diff == 0) {
+                if (!popPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    continue;
+                }
+                if (!slot->data.IsEmpty()) {
+                    break;
+                }
+                // slots released empty by the failed pushes are skipped
+                Release(*slot, pos);
+                pos = popPos_.load(std::memory_order_relaxed);
+            } else if (diff < 0) {
+                return false; // queue is empty
+            } else {
+                pos = popPos_.load(std::memory_order_relaxed);
+            }
+        }
+        if constexpr (std::is_invocable_v<F, RawData&, const EventRoute&>) {
+            handler(slot->data, slot->route);
+        } else {
+            handler(slot->data);
+        }
+        Release(*slot, pos);
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq { 0 };
+        RawData data;
+        EventRoute route;
+    };
+
+private:
+    void Release(Slot& slot, uint64_t pos);
+
+private:
+    uint32_t depth_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> pushPos_ { 0 };
+    std::atomic<uint64_t> popPos_ { 0 };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_QUEUE_H
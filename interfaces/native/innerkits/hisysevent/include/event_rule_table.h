@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_RULE_TABLE_H
+#define HISYSEVENT_EVENT_RULE_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "raw_data.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+struct EventRule {
+    uint64_t hash = 0;      // hash of domain and name, name "*" matches all events of the domain
+    uint8_t typeMask = 0;   // bit (type - 1) is set if events of the type are matched
+    uint8_t value = 0;      // decided by the user of the table, eg. the lane of the event
+};
+
+// rules of events searched by hashes of domain and name, no string is compared or copied while searching
+class EventRuleTable {
+public:
+    static constexpr char ANY_EVENT_NAME[] = "*";
+    static constexpr uint8_t ANY_TYPE_MASK = 0xF; // all of FAULT, STATISTIC, SECURITY and BEHAVIOR
+
+    static constexpr uint64_t GetEventHash(std::string_view domain, std::string_view name)
+    {
+        // fnv-1a, domain and name are separated by '\0' which is never a part of them
+        constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325ULL;
+        constexpr uint64_t fnvPrime = 0x100000001b3ULL;
+        uint64_t hash = fnvOffsetBasis;
+        for (auto c : domain) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * fnvPrime;
+        }
+        hash *= fnvPrime;
+        for (auto c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * fnvPrime;
+        }
+        return hash;
+    }
+
+    static constexpr uint8_t GetTypeMask(int type)
+    {
+        constexpr int minType = 1; // HiSysEvent::EventType::FAULT
+        constexpr int maxType = 4; // HiSysEvent::EventType::BEHAVIOR
+        return (type >= minType && type <= maxType) ? static_cast<uint8_t>(1U << (type - minType)) : 0;
+    }
+
+    static constexpr EventRule Rule(std::string_view domain, std::string_view name,
+        uint8_t typeMask = ANY_TYPE_MASK, uint8_t value = 0)
+    {
+        return EventRule { GetEventHash(domain, name), typeMask, value };
+    }
+
+    template<size_t N>
+    static constexpr std::array<EventRule, N> SortedRules(std::array<EventRule, N> rules)
+    {
+        for (size_t i = 1; i < N; ++i) {
+            for (size_t j = i; j > 0 && rules[j].hash < rules[j - 1].hash; --j) {
+                EventRule rule = rules[j];
+                rules[j] = rules[j - 1];
+                rules[j - 1] = rule;
+            }
+        }
+        return rules;
+    }
+
+    template<size_t N>
+    static constexpr bool IsCollisionFree(const std::array<EventRule, N>& sortedRules)
+    {
+        for (size_t i = 1; i < N; ++i) {
+            if (sortedRules[i].hash == sortedRules[i - 1].hash) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    // the rules are borrowed, which should be sorted by hash and never released
+    EventRuleTable(const EventRule* rules, size_t cnt);
+
+    // the rules are owned and sorted by hash, the former of rules with the same hash is matched first
+    explicit EventRuleTable(std::vector<EventRule> rules);
+    ~EventRuleTable() = default;
+    EventRuleTable(const EventRuleTable&) = delete;
+    EventRuleTable& operator=(const EventRuleTable&) = delete;
+
+public:
+    /*
+     * Find the rule matching the event, rules of the event itself take precedence over the ones of all events
+     * of the domain.
+     * @return nullptr if no rule matches.
+     */
+    const EventRule* Find(std::string_view domain, std::string_view name, int type) const;
+
+    // find the rule matching the event by the header in raw data, nullptr if no header is in the raw data
+    const EventRule* Find(const Encoded::RawData& data) const;
+    size_t GetRuleCount() const;
+
+public:
+    /*
+     * Parse a line of config, which is "DOMAIN NAME [TYPE ...]". NAME "*" means all events of the domain, all
+     * types are matched if no type is given, and the text after "#" is a comment.
+     * @return false if the line is invalid, nothing is appended for an empty line.
+     */
+    static bool RuleParsed(const std::string& line, uint8_t value, std::vector<EventRule>& rules);
+
+    /*
+     * Load the table from the config file, each line of which is parsed by RuleParsed with the value given.
+     * @return nullptr if the file fails to open or any line is invalid.
+     */
+    static std::unique_ptr<EventRuleTable> Load(const std::string& configPath, uint8_t value);
+
+private:
+    const EventRule* FindByHash(uint64_t hash, uint8_t typeMask) const;
+
+private:
+    const EventRule* rules_ = nullptr;
+    size_t cnt_ = 0;
+    std::vector<EventRule> storage_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_RULE_TABLE_H
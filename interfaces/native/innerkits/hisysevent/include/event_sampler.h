@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_SAMPLER_H
+#define HISYSEVENT_EVENT_SAMPLER_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class EventSampler {
+public:
+    static constexpr char SAMPLING_RATE_KEY[] = "SAMPLING_RATE"; // ratio of events kept, stamped into them
+
+public:
+    /*
+     * Sample BEHAVIOR events by the first policy matching them, the ones matched by no policy are all kept.
+     * Events without trace are sampled randomly by the policy of SAMPLE_BY_TRACE. Sampling is disabled if no
+     * policy is given, and counters of policies are reset once policies are set.
+     */
+    static bool SetPolicies(const std::vector<SamplingPolicy>& policies);
+    static bool IsEnabled();
+
+    // the rate of the policy matching the event is given, FULL_SAMPLING_RATE if no policy matches
+    static bool IsSampledIn(std::string_view domain, std::string_view name, uint32_t& rate);
+    static bool GetStats(uint32_t policy, SamplingStats& stats);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_SAMPLER_H
@@ -16,6 +16,9 @@
 #ifndef EVENT_SOCKET_FACTORY_H
 #define EVENT_SOCKET_FACTORY_H
 
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -25,9 +28,43 @@ namespace OHOS {
 namespace HiviewDFX {
 using namespace Encoded;
 using EventSocket = struct sockaddr_un;
+
+// decided once before the event is sent, and kept along with the event until it is sent
+struct EventRoute {
+    const EventSocket* socket = nullptr;
+    bool isUrgent = false; // events of higher priority or FAULT type, which are never delayed by batch mode
+};
+
 class EventSocketFactory {
 public:
-    static EventSocket& GetEventSocket(RawData& data);
+    static const EventSocket& GetEventSocket(RawData& data);
+    static const EventSocket& GetEventSocket(bool isHigherPriority);
+    static EventRoute GetEventRoute(std::string_view domain, std::string_view name, int type);
+    // the route of the event whose domain, name and type are unknown to the caller is decided by its header
+    static EventRoute GetEventRoute(RawData& data);
+
+    /*
+     * Events are routed by a table of hashes of domain and name, the route of an event is decided once before
+     * it is sent. The events with higher priority are built in, and are replaced by the ones configured in
+     * /system/etc/hiview/hisysevent_priority_events.cfg if the file exists.
+     */
+    static bool IsHigherPriorityEvent(std::string_view domain, std::string_view name, int type);
+
+    /*
+     * Replace the events with higher priority by the ones configured in the file, each line of which is
+     * "DOMAIN NAME [TYPE ...]", NAME "*" means all events of the domain and all types are matched if no type
+     * is given, eg. "RELIABILITY * FAULT". The built-in events are restored if the path is empty.
+     */
+    static bool LoadHigherPriorityEvents(const std::string& configPath);
+
+    /*
+     * Events are sent to the sockets listened by hiview by default, the paths can be changed to the ones listened
+     * by a local receiver, eg. in tests and benchmarks. The paths are published as a whole, events being sent by
+     * other threads go to either the previous paths or the new ones, and sockets connected to the previous paths
+     * are reconnected while sending the next events.
+     */
+    static bool SetSocketPath(const std::string& normalPath, const std::string& higherPriorityPath);
+    static uint32_t GetSocketPathGeneration();
 };
 }
 }
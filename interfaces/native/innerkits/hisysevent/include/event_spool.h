@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_SPOOL_H
+#define HISYSEVENT_EVENT_SPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "raw_data.h"
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Ring of encoded events kept in a memory mapped file of fixed size, so that events failed to send survive the
+ * exit of the process. Each record is checked by its length, sequence and checksum, and only the position of the
+ * oldest record is stored in the file, the records behind it are found by scanning while opening, so a torn
+ * record only ends the ring instead of being sent. Events written while the ring is full are dropped.
+ */
+class EventSpool {
+public:
+    static constexpr size_t FILE_HEADER_SIZE = 64; // the ring follows the header in the file
+
+public:
+    static EventSpool& GetInstance();
+
+    /*
+     * Open the spool file, which is created or reset if it is not a spool of the capacity given.
+     * @return false if the file fails to open, map or lock, eg. it is opened by another process.
+     */
+    bool Open(const std::string& path, uint32_t capacity);
+    void Close();
+    bool IsOpened() const;
+    bool IsEmpty() const;
+
+    // false if the spool is not opened or full
+    bool Append(const Encoded::RawData& rawData);
+
+    // copy the oldest event, which is kept until Pop is called
+    bool Front(Encoded::RawData& rawData) const;
+    void Pop();
+    void GetStats(EventSpoolStats& stats) const;
+
+private:
+    EventSpool() = default;
+    ~EventSpool() = default;
+    EventSpool(const EventSpool&) = delete;
+    EventSpool& operator=(const EventSpool&) = delete;
+
+    // should be called with mutex_ locked
+    bool Map(int fd, uint32_t capacity);
+    void Unmap();
+    void Recover();
+    uint32_t SkipWrap(uint32_t pos) const;
+    void StoreCursor();
+
+private:
+    struct FileHeader;
+    mutable std::mutex mutex_;
+    std::atomic<bool> isOpened_ { false };
+    std::atomic<uint64_t> pendingCnt_ { 0 };
+    int fd_ = -1;
+    FileHeader* header_ = nullptr;
+    uint8_t* ring_ = nullptr;
+    uint32_t capacity_ = 0;
+    uint32_t readPos_ = 0;
+    uint32_t readSeq_ = 0;
+    uint32_t writePos_ = 0;
+    uint32_t usedBytes_ = 0;
+    uint64_t spooledCnt_ = 0;
+    uint64_t drainedCnt_ = 0;
+    uint64_t recoveredCnt_ = 0;
+    uint64_t droppedCnt_ = 0;
+    uint64_t tornCnt_ = 0;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_SPOOL_H
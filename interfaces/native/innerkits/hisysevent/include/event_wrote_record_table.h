@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_EVENT_WROTE_RECORD_TABLE_H
+#define HISYSEVENT_EVENT_WROTE_RECORD_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "write_controller.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+// lock-free open-addressing table, the slot having the earliest record in the probe window will be
+// reused once the window is full, so that the limitation is best-effort under heavy collisions
+class EventWroteRecordTable {
+public:
+    static constexpr size_t TABLE_SIZE = 256; // must be power of 2
+    static constexpr size_t PROBE_LIMIT = 8;
+
+public:
+    // find the record of the call site by the key, which is inserted if not found
+    CallSiteRecord& GetRecord(uint64_t key);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key { 0 }; // 0 marks the empty slot
+        CallSiteRecord record { 0 };
+    };
+
+private:
+    Slot slots_[TABLE_SIZE];
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_EVENT_WROTE_RECORD_TABLE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -18,10 +18,18 @@
 
 #ifdef __cplusplus
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <type_traits>
 #include <vector>
+#if __has_include(<span>) && (__cplusplus > 201703L)
+#include <span>
+#endif
 
 #include "encoded_param.h"
 #include "def.h"
@@ -29,6 +37,7 @@
 #include "raw_data.h"
 #include "stringfilter.h"
 #include "write_controller.h"
+#include "write_option_def.h"
 
 /*
  * Usage: define string macro "DOMAIN_MASKS" to disable one or more components.
@@ -66,9 +75,33 @@ struct IsMaskedCvt {
     inline static constexpr bool value = IsMaskedImpl<domainView, domainMasksView>::value;
 };
 
+// event name is a constant at the call site, eg. string literal, so that the call site can be
+// identified by a static record instead of the key built from event name, function and line
+template<typename T>
+inline static constexpr bool isConstEventName = std::is_array_v<std::remove_reference_t<T>> &&
+    std::is_const_v<std::remove_extent_t<std::remove_reference_t<T>>>;
+
 template<const char* domain>
 inline static constexpr bool isMasked = IsMaskedCvt<domain, DOMAIN_MASKS_DEF>::value;
 
+// domain is validated at compile time, so that it need not be validated again while writing events
+template<const char* domain>
+inline static constexpr bool isValidDomain = StringFilter::IsValidConstName(domain, MAX_DOMAIN_LENGTH);
+
+template<typename T>
+inline static constexpr bool isStringItem = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+// type of items which can be encoded from arrays without copying them into std::vector
+template<typename T>
+inline static constexpr bool isArrayItem = std::is_integral_v<T> || Encoded::isFloatingNum<T> || isStringItem<T>;
+
+// integers of any width are encoded as varint of 64 bits and char is taken as signed, same as std::vector
+template<typename T>
+using ArrayItemEncodedType = std::conditional_t<isStringItem<T>, Encoded::EscapedString,
+    std::conditional_t<std::is_same_v<T, bool> || !std::is_integral_v<T>, T,
+    std::conditional_t<std::is_signed_v<T> || std::is_same_v<T, char>, int64_t, uint64_t>>>;
+
 class HiSysEvent {
 public:
     friend class HiSysEvent;
@@ -263,63 +296,190 @@ public:
 public:
     template<typename... Types>
     static int Write(const char* func, int64_t line, const std::string &domain,
-        const std::string &eventName, EventType type, Types... keyValues)
+        const std::string &eventName, EventType type, const Types&... keyValues)
     {
-        ControlParam param = {
-#ifdef HISYSEVENT_PERIOD
-            HISYSEVENT_PERIOD,
-#else
-            HISYSEVENT_DEFAULT_PERIOD,
-#endif
-#ifdef HISYSEVENT_THRESHOLD
-            HISYSEVENT_THRESHOLD
-#else
-            HISYSEVENT_DEFAULT_THRESHOLD
-#endif
-        };
-        uint64_t timeStamp = WriteController::CheckLimitWritingEvent(param, domain.c_str(), eventName.c_str(),
-            func, line);
-        if (timeStamp == INVALID_TIME_STAMP) {
-            return ERR_WRITE_IN_HIGH_FREQ;
-        }
-        return InnerWrite(domain, eventName, type, timeStamp, keyValues...);
+        return WriteAtCallSite(func, line, nullptr, domain, eventName, type,
+            [&keyValues...] (EventBase& eventBase) { InnerWrite(eventBase, keyValues...); });
     }
 
     template<const char* domain, typename... Types, std::enable_if_t<!isMasked<domain>>* = nullptr>
     static int Write(const char* func, int64_t line, const std::string& eventName,
-        EventType type, Types... keyValues)
+        EventType type, const Types&... keyValues)
     {
-        ControlParam param = {
-#ifdef HISYSEVENT_PERIOD
-            HISYSEVENT_PERIOD,
-#else
-            HISYSEVENT_DEFAULT_PERIOD,
-#endif
-#ifdef HISYSEVENT_THRESHOLD
-            HISYSEVENT_THRESHOLD
-#else
-            HISYSEVENT_DEFAULT_THRESHOLD
-#endif
-        };
-        uint64_t timeStamp = WriteController::CheckLimitWritingEvent(param, domain, eventName.c_str(),
-            func, line);
-        if (timeStamp == INVALID_TIME_STAMP) {
-            return ERR_WRITE_IN_HIGH_FREQ;
-        }
-        return InnerWrite(std::string(domain), eventName, type, timeStamp, keyValues...);
+        return WriteAtCallSite<isValidDomain<domain>>(func, line, nullptr, std::string(domain), eventName, type,
+            [&keyValues...] (EventBase& eventBase) { InnerWrite(eventBase, keyValues...); });
     }
 
     template<const char* domain, typename... Types, std::enable_if_t<isMasked<domain>>* = nullptr>
-    inline static constexpr int Write(const char*, int64_t, const std::string&, EventType, Types...)
+    inline static constexpr int Write(const char*, int64_t, const std::string&, EventType, const Types&...)
     {
         // do nothing
         return ERR_DOMAIN_MASKED;
     }
 
+    template<const char* domain, typename... Types, std::enable_if_t<!isMasked<domain>>* = nullptr>
+    static int Write(CallSiteRecord& record, const char* func, const std::string& eventName,
+        EventType type, const Types&... keyValues)
+    {
+        return WriteAtCallSite<isValidDomain<domain>>(func, 0, &record, std::string(domain), eventName, type,
+            [&keyValues...] (EventBase& eventBase) { InnerWrite(eventBase, keyValues...); });
+    }
+
+    /**
+     * @brief Stage events written by each thread and send them together, which suits the process writing
+     *     events in bursts. Events of FAULT type or higher priority are always sent immediately.
+     * @param enabled        enable batch mode or not.
+     * @param batchSize      count of staged events to send together, no more than MAX_BATCH_SIZE.
+     * @param latencyBudget  max milliseconds to stage an event, the staged events are sent by a background
+     *     thread once it is used up if the thread writes no more events.
+     */
+    static void SetBatchMode(bool enabled, uint32_t batchSize = DEFAULT_BATCH_SIZE,
+        uint32_t latencyBudget = DEFAULT_BATCH_LATENCY_BUDGET);
+
+    /**
+     * @brief Send the events staged by the calling thread immediately.
+     * @return 0 means success, less than 0 means failure.
+     */
+    static int Flush();
+
+    /**
+     * @brief Only encode events on the calling thread and leave them to a background thread to send, the
+     *     result of validation is still returned synchronously while failure of sending is not.
+     * @param enabled     enable async mode or not.
+     * @param queueDepth  max count of queued events, only takes effect when async mode is enabled at first time.
+     * @param policy      the way to handle the event written while the queue is full.
+     */
+    static void SetAsyncMode(bool enabled, uint32_t queueDepth = DEFAULT_ASYNC_QUEUE_DEPTH,
+        AsyncDropPolicy policy = AsyncDropPolicy::DROP_NEWEST);
+
+    /**
+     * @brief Get count of events dropped by async mode because the queue is full.
+     * @return count of dropped events.
+     */
+    static uint64_t GetAsyncDroppedCount();
+
+    /**
+     * @brief Send events in async mode by lanes in order of priority, each of which has its own queue, drop
+     *     policy and background thread, so that events of a lane are never delayed by the ones of lanes behind.
+     *     Events are sent by the first lane matching them, the ones matched by no lane are sent by the last one.
+     * @param lanes  lanes in order of priority, no more than MAX_PRIORITY_LANE_CNT.
+     * @return true if the lanes are set and the async mode is enabled.
+     */
+    static bool SetAsyncPriorityLanes(const std::vector<PriorityLaneConfig>& lanes);
+
+    /**
+     * @brief Get counters of the lane of async mode.
+     * @param lane   index of the lane.
+     * @param stats  counters of events sent, failed and dropped, and the high-water mark of the queue.
+     * @return false if the lane does not exist.
+     */
+    static bool GetAsyncPriorityLaneStats(uint32_t lane, PriorityLaneStats& stats);
+
+    /**
+     * @brief Stop sending events after sustained failures of sending, while hiview is overloaded or unavailable,
+     *     so that the writing threads fail fast and leave the events to be retried. hiview is probed with
+     *     exponential backoff and events are sent as usual once it is available again. Enabled by default.
+     * @param enabled           enable the breaker or not.
+     * @param failureThreshold  count of consecutive failures to open the breaker.
+     * @param maxBackoff        max milliseconds between the probes.
+     */
+    static void SetCircuitBreaker(bool enabled, uint32_t failureThreshold = DEFAULT_CIRCUIT_FAILURE_THRESHOLD,
+        uint32_t maxBackoff = DEFAULT_CIRCUIT_MAX_BACKOFF);
+
+    /**
+     * @brief Get the state and counters of the breaker, which tell whether and how long the process has been
+     *     failing fast.
+     * @param stats  state, transitions, probes and events failed fast of the breaker.
+     */
+    static void GetCircuitBreakerStats(CircuitBreakerStats& stats);
+
+    /**
+     * @brief Keep FAULT events failed to send in a file of the process instead of the retry queue in memory, so
+     *     that they are sent in order once hiview is available, even by the process started next time. The file
+     *     is of fixed size and events written while it is full are left to the retry queue.
+     * @param enabled   enable the spool or not, events left in the file are kept while it is disabled.
+     * @param path      path of the file, which must not be shared by processes.
+     * @param capacity  bytes of the file to store events, between MIN_SPOOL_CAPACITY and MAX_SPOOL_CAPACITY.
+     * @return false if the file fails to open, eg. it is opened by another process.
+     */
+    static bool SetEventSpool(bool enabled, const std::string& path = "", uint32_t capacity = DEFAULT_SPOOL_CAPACITY);
+
+    /**
+     * @brief Get the counters of the spool.
+     * @param stats  events appended, sent, dropped and left in the file, and records found torn while opening.
+     */
+    static void GetEventSpoolStats(EventSpoolStats& stats);
+
+    /**
+     * @brief Fold STATISTIC events written repeatedly at the same call site instead of limiting them. The first
+     *     event of each group is sent at once, and the following ones during the window are folded into one
+     *     summary, which has the sum, min and max of each numeric parameter and the count of events folded. The
+     *     events of a group have the same domain, name, call site, keys and non numeric values. Sum, min and max
+     *     of the summary are widened to INT64, UINT64 or DOUBLE, whatever the type of the parameter is.
+     * @param enabled  enable aggregation or not, the summaries are sent before it is disabled.
+     * @param window   milliseconds from the first event of a group to the summary of the following ones.
+     */
+    static void SetStatisticAggregation(bool enabled, uint32_t window = DEFAULT_AGGREGATION_WINDOW);
+
+    /**
+     * @brief Get the counters of aggregation.
+     * @param stats  events sent, folded and discarded, and summaries sent.
+     */
+    static void GetStatisticAggregationStats(AggregationStats& stats);
+
+    /**
+     * @brief Load token bucket budgets of events and bytes written by each call site, each domain and the whole
+     *     process, events out of any budget are discarded with ERR_WRITE_IN_HIGH_FREQ. The budgets are taken
+     *     from /system/etc/hiview/hisysevent_rate_limit.cfg by default if it exists.
+     * @param configPath  path of the config, each line of which is "SCOPE [DOMAIN] EVENT_RATE EVENT_BURST
+     *     [BYTE_RATE BYTE_BURST]", SCOPE is one of PROCESS, DOMAIN and CALL_SITE, and DOMAIN "*" is the budget
+     *     of each domain not given. Limiting by budgets is disabled if the path is empty. The budget of
+     *     CALL_SITE takes the place of the period and threshold of each call site once it is loaded.
+     * @return false if the config is invalid, the budgets in use are kept.
+     */
+    static bool SetRateLimit(const std::string& configPath);
+
+    /**
+     * @brief Get the counters of limiting by budgets.
+     * @param stats  events passed and discarded by each scope, and call sites tracked.
+     */
+    static void GetRateLimitStats(RateLimitStats& stats);
+
+    /**
+     * @brief Keep only part of BEHAVIOR events before they are encoded, each event kept is stamped with the rate
+     *     of its policy as parameter SAMPLING_RATE, so that consumers can weight it by the reciprocal. Events
+     *     dropped by sampling are still taken as written successfully, while the ones kept are discarded with
+     *     ERR_KEY_NUMBER_TOO_MUCH if they already have MAX_PARAM_NUMBER parameters and the rate has no room.
+     * @param policies  rates, modes and events of the policies, the first policy matching an event is used.
+     *     Sampling is disabled if no policy is given.
+     * @return false if any policy is invalid, the policies in use are kept.
+     */
+    static bool SetSamplingPolicies(const std::vector<SamplingPolicy>& policies);
+
+    /**
+     * @brief Get the counters of a sampling policy.
+     * @param policy  index of the policy.
+     * @param stats   events kept and dropped by the policy since it is set.
+     * @return false if the policy does not exist.
+     */
+    static bool GetSamplingStats(uint32_t policy, SamplingStats& stats);
+
+    /**
+     * @brief Encode items of float and double arrays as packed fixed width values instead of one by one, which
+     *     makes events smaller and faster to encode. Only enable it if the receiver is able to decode them.
+     * @param enabled  enable packed array or not.
+     */
+    static void SetPackedArrayMode(bool enabled);
+
 private:
+    template<const char* domain, const char* eventName, EventType type, typename... Keys>
+    friend class HiSysEventSchema;
+
     class EventBase {
     public:
         EventBase(const std::string& domain, const std::string& eventName, int type, uint64_t timeStamp = 0);
+        EventBase(const std::string& domain, const std::string& eventName, int type, uint64_t timeStamp,
+            bool isDomainChecked);
         ~EventBase() = default;
 
     public:
@@ -329,6 +489,89 @@ private:
         void WritebaseInfo();
         size_t GetParamCnt();
         std::shared_ptr<Encoded::RawData> GetEventRawData();
+        std::string_view GetDomain() const;
+        std::string_view GetEventName() const;
+        int GetEventType() const;
+
+        template<typename T>
+        void AppendParam(const std::string& key, const T& value)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            size_t begin = rawData_->GetDataLength();
+            if (Encoded::ParamEncoder::ParamEncoded<T>(*rawData_, key, value)) {
+                paramCnt_++;
+                ParamDigested(begin, key.length(), value);
+            }
+        }
+
+        template<typename T, typename Iter, typename... Convertor>
+        void AppendArrayParam(const std::string& key, Iter begin, size_t size, Convertor... convertor)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            size_t paramBegin = rawData_->GetDataLength();
+            if (Encoded::ParamEncoder::ArrayParamEncoded<T>(*rawData_, key, begin, size, convertor...)) {
+                paramCnt_++;
+                ParamDigested(paramBegin);
+            }
+        }
+
+        // key and value type of the parameter have been encoded at compile time
+        template<typename ValueEncoder>
+        void AppendEncodedKeyParam(const uint8_t* encodedKey, size_t len, ValueEncoder valueEncoder)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            size_t begin = rawData_->GetDataLength();
+            if (rawData_->Append(const_cast<uint8_t*>(encodedKey), len) && valueEncoder(*rawData_)) {
+                paramCnt_++;
+                ParamDigested(begin);
+            }
+        }
+
+        // key and value type of the numeric parameter have been encoded at compile time
+        template<typename T>
+        void AppendEncodedKeyNumericParam(const uint8_t* encodedKey, size_t len, size_t keyLen, T value)
+        {
+            if (rawData_ == nullptr) {
+                return;
+            }
+            size_t begin = rawData_->GetDataLength();
+            if (rawData_->Append(const_cast<uint8_t*>(encodedKey), len) &&
+                Encoded::ParamEncoder::ValueEncoded<T>(*rawData_, value)) {
+                paramCnt_++;
+                ParamDigested(begin, keyLen, value);
+            }
+        }
+
+        // parameters appended after are digested until the event is aggregated, see AggregatedWrite
+        void EnableParamDigest();
+        const Encoded::ParamDigest* GetParamDigest() const;
+
+    private:
+        template<typename T>
+        void ParamDigested(size_t begin, size_t keyLen, const T& value)
+        {
+            if (paramDigest_ == nullptr) {
+                return;
+            }
+            if constexpr (Encoded::isUnsignedNum<T> || Encoded::isSignedNum<T> || Encoded::isFloatingNum<T>) {
+                paramDigest_->NumericParamAppended(begin, keyLen, rawData_->GetDataLength(), value);
+            } else {
+                paramDigest_->ParamAppended(begin, rawData_->GetDataLength());
+            }
+        }
+
+        void ParamDigested(size_t begin)
+        {
+            if (paramDigest_ != nullptr) {
+                paramDigest_->ParamAppended(begin, rawData_->GetDataLength());
+            }
+        }
 
     private:
         int retCode_ = 0;
@@ -341,32 +584,110 @@ private:
             0, 0, 0, 0
         };
         std::shared_ptr<Encoded::RawData> rawData_ = nullptr;
+        Encoded::ParamDigest* paramDigest_ = nullptr;
     };
 
 private:
-    template<typename... Types>
-    static int InnerWrite(const std::string& domain, const std::string& eventName,
-        int type, uint64_t timeStamp, Types... keyValues)
+    /*
+     * Steps shared by all ways of writing events at a call site, which is identified by the static record if it
+     * is given, or by the function and line otherwise. BEHAVIOR events may be sampled out, STATISTIC events are
+     * folded if aggregation is enabled, and the others are limited by the call site before the parameters are
+     * encoded by the encoder.
+     */
+    template<bool isDomainChecked = false, typename Encoder>
+    static int WriteAtCallSite(const char* func, int64_t line, CallSiteRecord* record, const std::string& domain,
+        const std::string& eventName, EventType type, const Encoder& encoder)
     {
-        EventBase eventBase(domain, eventName, type, timeStamp);
-        if (IsError(eventBase)) {
-            return ExplainThenReturnRetCode(eventBase.GetRetCode());
+        uint32_t samplingRate = FULL_SAMPLING_RATE;
+        if (type == EventType::BEHAVIOR && IsSampledOut(domain, eventName, samplingRate)) {
+            return SUCCESS;
         }
+        uint64_t callSite = (record != nullptr) ? reinterpret_cast<uintptr_t>(record) : GetCallSite(func, line);
+        if (type == EventType::STATISTIC && IsStatisticAggregated()) {
+            return AggregatedWrite<isDomainChecked>(callSite, domain, eventName, encoder);
+        }
+        // the budget of call sites loaded takes the place of the period and threshold, see SetRateLimit
+        if (IsCallSiteRateLimited()) {
+            return InnerWrite<isDomainChecked>(callSite, samplingRate, domain, eventName, type,
+                WriteController::GetCurrentTimeMills(), encoder);
+        }
+        ControlParam param = {
+#ifdef HISYSEVENT_PERIOD
+            HISYSEVENT_PERIOD,
+#else
+            HISYSEVENT_DEFAULT_PERIOD,
+#endif
+#ifdef HISYSEVENT_THRESHOLD
+            HISYSEVENT_THRESHOLD
+#else
+            HISYSEVENT_DEFAULT_THRESHOLD
+#endif
+        };
+        uint64_t timeStamp = (record != nullptr) ?
+            WriteController::CheckLimitWritingEvent(param, domain.c_str(), eventName.c_str(), func, *record) :
+            WriteController::CheckLimitWritingEvent(param, domain.c_str(), eventName.c_str(), func, line);
+        if (timeStamp == INVALID_TIME_STAMP) {
+            return ERR_WRITE_IN_HIGH_FREQ;
+        }
+        return InnerWrite<isDomainChecked>(callSite, samplingRate, domain, eventName, type, timeStamp, encoder);
+    }
 
-        WritebaseInfo(eventBase);
-        if (IsError(eventBase)) {
+    template<bool isDomainChecked = false, typename Encoder>
+    static int InnerWrite(uint64_t callSite, uint32_t samplingRate, const std::string& domain,
+        const std::string& eventName, int type, uint64_t timeStamp, const Encoder& encoder)
+    {
+        EventBase eventBase(domain, eventName, type, timeStamp, isDomainChecked);
+        if (!IsEventEncoded(eventBase, encoder)) {
+            return ExplainThenReturnRetCode(eventBase.GetRetCode());
+        }
+        if (samplingRate != FULL_SAMPLING_RATE && !AppendSamplingRate(eventBase, samplingRate)) {
             return ExplainThenReturnRetCode(eventBase.GetRetCode());
         }
 
-        InnerWrite(eventBase, keyValues...);
-        if (IsError(eventBase)) {
+        SendSysEvent(eventBase, callSite);
+        return eventBase.GetRetCode();
+    }
+
+    // STATISTIC events are not limited by the call site, since the repeated ones are folded
+    template<bool isDomainChecked = false, typename Encoder>
+    static int AggregatedWrite(uint64_t callSite, const std::string& domain, const std::string& eventName,
+        const Encoder& encoder)
+    {
+        EventBase eventBase(domain, eventName, EventType::STATISTIC, WriteController::GetCurrentTimeMills(),
+            isDomainChecked);
+        eventBase.EnableParamDigest();
+        if (!IsEventEncoded(eventBase, encoder)) {
             return ExplainThenReturnRetCode(eventBase.GetRetCode());
         }
 
-        SendSysEvent(eventBase);
+        AggregateSysEvent(eventBase, callSite);
         return eventBase.GetRetCode();
     }
 
+    // parameters are appended by the encoder after the header is written
+    template<typename Encoder>
+    static bool IsEventEncoded(EventBase& eventBase, const Encoder& encoder)
+    {
+        if (IsError(eventBase)) {
+            return false;
+        }
+
+        WritebaseInfo(eventBase);
+        if (IsError(eventBase)) {
+            return false;
+        }
+
+        encoder(eventBase);
+        return !IsError(eventBase);
+    }
+
+    // call site of the event written with the function and line, where the function name is a literal
+    static uint64_t GetCallSite(const char* func, int64_t line)
+    {
+        return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(func)) * 0x100000001b3ULL) ^ // fnv prime
+            static_cast<uint64_t>(line);
+    }
+
     static bool CheckParamValidity(EventBase& eventBase, const std::string &key)
     {
         if (IsWarnAndUpdate(CheckKey(key), eventBase)) {
@@ -388,356 +709,380 @@ private:
         return true;
     }
 
-    template<typename T>
-    static bool CheckArrayParamsValidity(EventBase& eventBase, const std::string& key, const std::vector<T>& value)
+    static bool CheckArrayParamsValidity(EventBase& eventBase, const std::string& key, size_t size)
     {
         if (!CheckParamValidity(eventBase, key)) {
             return false;
         }
-        if (value.empty()) {
-            std::vector<bool> boolArrayValue;
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(key,
-                boolArrayValue));
+        if (size == 0) {
+            eventBase.AppendArrayParam<bool>(key, static_cast<const bool*>(nullptr), 0);
             return false;
         }
-        IsWarnAndUpdate(CheckArraySize(value.size()), eventBase);
+        IsWarnAndUpdate(CheckArraySize(size), eventBase);
         return true;
     }
 
+    template<typename T>
+    static bool CheckArrayParamsValidity(EventBase& eventBase, const std::string& key, const std::vector<T>& value)
+    {
+        return CheckArrayParamsValidity(eventBase, key, value.size());
+    }
+
+    // items are encoded from the memory of caller directly without being copied into std::vector
+    template<typename T>
+    static void AppendArrayParam(EventBase& eventBase, const std::string& key, const T* array, size_t size)
+    {
+        if constexpr (std::is_pointer_v<T>) {
+            for (size_t i = 0; i < size; ++i) {
+                if (array[i] == nullptr) {
+                    eventBase.SetRetCode(ERR_VALUE_INVALID);
+                    return;
+                }
+            }
+        }
+        if (!CheckArrayParamsValidity(eventBase, key, size)) {
+            return;
+        }
+        if constexpr (isStringItem<T>) {
+            for (size_t i = 0; i < size; ++i) {
+                IsWarnAndUpdate(CheckValueLength(std::string_view(array[i]).length()), eventBase);
+            }
+            eventBase.AppendArrayParam<Encoded::EscapedString>(key, array, size, [] (const T& item) {
+                std::string_view str(item);
+                return Encoded::EscapedString { str.data(), str.length() };
+            });
+        } else {
+            eventBase.AppendArrayParam<ArrayItemEncodedType<T>>(key, array, size);
+        }
+    }
+
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, bool value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, bool value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<bool>>(key, value));
+            eventBase.AppendParam(key, value);
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const char value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const char value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int8_t>>(key,
-                static_cast<int8_t>(value)));
+            eventBase.AppendParam(key, static_cast<int8_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned char value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint8_t>>(key,
-                static_cast<uint8_t>(value)));
+            eventBase.AppendParam(key, static_cast<uint8_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const short value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const short value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int16_t>>(key,
-                static_cast<int16_t>(value)));
+            eventBase.AppendParam(key, static_cast<int16_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned short value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint16_t>>(key,
-                static_cast<uint16_t>(value)));
+            eventBase.AppendParam(key, static_cast<uint16_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const int value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const int value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int32_t>>(key, value));
+            eventBase.AppendParam(key, value);
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned int value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint32_t>>(key, value));
+            eventBase.AppendParam(key, value);
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const long value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const long value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(key,
-                static_cast<int64_t>(value)));
+            eventBase.AppendParam(key, static_cast<int64_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned long value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key,
-                static_cast<uint64_t>(value)));
+            eventBase.AppendParam(key, static_cast<uint64_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const long long value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const long long value,
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedParam<int64_t>>(key,
-                static_cast<int64_t>(value)));
+            eventBase.AppendParam(key, static_cast<int64_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const unsigned long long value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedParam<uint64_t>>(key,
-                static_cast<uint64_t>(value)));
+            eventBase.AppendParam(key, static_cast<uint64_t>(value));
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const float value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const float value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<float>>(key, value));
+            eventBase.AppendParam(key, value);
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const double value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const double value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedParam<double>>(key, value));
+            eventBase.AppendParam(key, value);
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::string& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
             IsWarnAndUpdate(CheckValue(value), eventBase);
-            auto rawStr = StringFilter::GetInstance().EscapeToRaw(value);
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(key, rawStr));
+            eventBase.AppendParam(key, Encoded::EscapedString { value.c_str(), value.length() });
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
-    static void InnerWrite(EventBase& eventBase, const std::string& key, const char* value, Types... keyValues)
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const char* value, const Types&... keyValues)
     {
         if (CheckParamValidity(eventBase, key)) {
-            IsWarnAndUpdate(CheckValue(std::string(value)), eventBase);
-            auto rawStr = StringFilter::GetInstance().EscapeToRaw(std::string(value));
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedParam>(key, std::string(rawStr)));
+            size_t len = strlen(value);
+            IsWarnAndUpdate(CheckValueLength(len), eventBase);
+            eventBase.AppendParam(key, Encoded::EscapedString { value, len });
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<bool>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<bool>>(key, value));
+            eventBase.AppendArrayParam<bool>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<char>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int8_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int8_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int8_t>>(key, translated));
+            eventBase.AppendArrayParam<int8_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned char>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint8_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint8_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint8_t>>(key,
-                translated));
+            eventBase.AppendArrayParam<uint8_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<short>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int16_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int16_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int16_t>>(key, translated));
+            eventBase.AppendArrayParam<int16_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned short>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint16_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint16_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint16_t>>(key,
-                translated));
+            eventBase.AppendArrayParam<uint16_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<int>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int32_t>>(key, value));
+            eventBase.AppendArrayParam<int32_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned int>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint32_t>>(key, value));
+            eventBase.AppendArrayParam<uint32_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<long>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(key, translated));
+            eventBase.AppendArrayParam<int64_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned long>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(key,
-                translated));
+            eventBase.AppendArrayParam<uint64_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<long long>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<int64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<int64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::SignedVarintEncodedArrayParam<int64_t>>(key, translated));
+            eventBase.AppendArrayParam<int64_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<unsigned long long>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<uint64_t> translated;
-            for (auto item : value) {
-                translated.emplace_back(static_cast<uint64_t>(item));
-            }
-            eventBase.AppendParam(std::make_shared<Encoded::UnsignedVarintEncodedArrayParam<uint64_t>>(key,
-                translated));
+            eventBase.AppendArrayParam<uint64_t>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<float>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<float>>(key, value));
+            eventBase.AppendArrayParam<float>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<double>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            eventBase.AppendParam(std::make_shared<Encoded::FloatingNumberEncodedArrayParam<double>>(key, value));
+            eventBase.AppendArrayParam<double>(key, value.begin(), value.size());
         }
         InnerWrite(eventBase, keyValues...);
     }
 
     template<typename... Types>
     static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<std::string>& value,
-        Types... keyValues)
+        const Types&... keyValues)
     {
         if (CheckArrayParamsValidity(eventBase, key, value)) {
-            std::vector<std::string> rawStrs;
             for (auto& item : value) {
                 IsWarnAndUpdate(CheckValue(item), eventBase);
-                rawStrs.emplace_back(StringFilter::GetInstance().EscapeToRaw(item));
             }
-            eventBase.AppendParam(std::make_shared<Encoded::StringEncodedArrayParam>(key, rawStrs));
+            eventBase.AppendArrayParam<Encoded::EscapedString>(key, value.begin(), value.size(),
+                [] (const std::string& item) {
+                    return Encoded::EscapedString { item.c_str(), item.length() };
+                });
         }
         InnerWrite(eventBase, keyValues...);
     }
 
+    template<typename... Types>
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::vector<std::string_view>& value,
+        const Types&... keyValues)
+    {
+        AppendArrayParam(eventBase, key, value.data(), value.size());
+        InnerWrite(eventBase, keyValues...);
+    }
+
+    template<typename T, size_t N, typename... Types, std::enable_if_t<isArrayItem<T>>* = nullptr>
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::array<T, N>& value,
+        const Types&... keyValues)
+    {
+        AppendArrayParam(eventBase, key, value.data(), N);
+        InnerWrite(eventBase, keyValues...);
+    }
+
+#ifdef __cpp_lib_span
+    template<typename T, size_t N, typename... Types, std::enable_if_t<isArrayItem<std::remove_cv_t<T>>>* = nullptr>
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const std::span<T, N>& value,
+        const Types&... keyValues)
+    {
+        AppendArrayParam<std::remove_cv_t<T>>(eventBase, key, value.data(), value.size());
+        InnerWrite(eventBase, keyValues...);
+    }
+#endif
+
+    // char arrays are taken as strings rather than arrays of int8_t
+    template<typename T, size_t N, typename... Types,
+        std::enable_if_t<isArrayItem<T> && !std::is_same_v<T, char>>* = nullptr>
+    static void InnerWrite(EventBase& eventBase, const std::string& key, const T (&value)[N],
+        const Types&... keyValues)
+    {
+        AppendArrayParam(eventBase, key, value, N);
+        InnerWrite(eventBase, keyValues...);
+    }
+
 private:
     static void InnerWrite(EventBase& eventBase);
     static void InnerWrite(EventBase& eventBase, const HiSysEventParam params[], size_t size);
@@ -745,6 +1090,7 @@ private:
     static void AppendHexData(EventBase& eventBase, const std::string& key, uint64_t value);
     static int CheckKey(const std::string& key);
     static int CheckValue(const std::string& value);
+    static int CheckValueLength(const size_t length);
     static int CheckArraySize(const size_t size);
     static bool IsErrorAndUpdate(int retCode, EventBase& eventBase);
     static bool IsWarnAndUpdate(int retCode, EventBase& eventBase);
@@ -752,6 +1098,12 @@ private:
     static bool IsError(EventBase& eventBase);
     static int ExplainThenReturnRetCode(const int retCode);
     static void SendSysEvent(EventBase& eventBase);
+    static void SendSysEvent(EventBase& eventBase, uint64_t callSite);
+    static bool IsStatisticAggregated();
+    static bool IsCallSiteRateLimited();
+    static void AggregateSysEvent(EventBase& eventBase, uint64_t callSite);
+    static bool IsSampledOut(std::string_view domain, std::string_view eventName, uint32_t& samplingRate);
+    static bool AppendSamplingRate(EventBase& eventBase, uint32_t samplingRate);
     static void AppendInvalidParam(EventBase& eventBase, const HiSysEventParam& param);
     static void AppendBoolParam(EventBase& eventBase, const HiSysEventParam& param);
     static void AppendInt8Param(EventBase& eventBase, const HiSysEventParam& param);
@@ -793,8 +1145,14 @@ private:
 ({ \
     int hiSysEventWriteRet2023___ = OHOS::HiviewDFX::ERR_DOMAIN_MASKED; \
     if constexpr (!OHOS::HiviewDFX::isMasked<domain>) { \
-        hiSysEventWriteRet2023___ = OHOS::HiviewDFX::HiSysEvent::Write<domain>(__FUNCTION__, __LINE__, \
-            eventName, type, ##__VA_ARGS__); \
+        if constexpr (OHOS::HiviewDFX::isConstEventName<decltype(eventName)>) { \
+            static OHOS::HiviewDFX::CallSiteRecord hiSysEventCallSiteRecord2026___ { 0 }; \
+            hiSysEventWriteRet2023___ = OHOS::HiviewDFX::HiSysEvent::Write<domain>( \
+                hiSysEventCallSiteRecord2026___, __FUNCTION__, eventName, type, ##__VA_ARGS__); \
+        } else { \
+            hiSysEventWriteRet2023___ = OHOS::HiviewDFX::HiSysEvent::Write<domain>(__FUNCTION__, __LINE__, \
+                eventName, type, ##__VA_ARGS__); \
+        } \
     } \
     hiSysEventWriteRet2023___; \
 })
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_SCHEMA_H
+#define HISYSEVENT_SCHEMA_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "def.h"
+#include "encoded_param.h"
+#include "hisysevent.h"
+#include "raw_data.h"
+#include "stringfilter.h"
+#include "write_controller.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+template<typename T>
+inline static constexpr bool isSchemaScalarType = Encoded::isUnsignedNum<T> || Encoded::isSignedNum<T> ||
+    Encoded::isFloatingNum<T> || std::is_same_v<T, std::string>;
+
+template<typename T>
+struct SchemaTypeTraits {
+    static constexpr bool IS_ARRAY = false;
+    using ItemType = T;
+};
+
+template<typename T>
+struct SchemaTypeTraits<std::vector<T>> {
+    static constexpr bool IS_ARRAY = true;
+    using ItemType = T;
+};
+
+// value given while writing should have the same kind as the type declared in schema, eg. integer for integer
+template<typename T, typename V>
+inline static constexpr bool isSchemaCompatibleType = std::is_same_v<T, std::string> ?
+    std::is_convertible_v<const V&, std::string_view> :
+    (std::is_same_v<T, bool> ? std::is_same_v<V, bool> :
+    (std::is_integral_v<T> ? (std::is_integral_v<V> && !std::is_same_v<V, bool>) :
+    (std::is_floating_point_v<T> ? (std::is_arithmetic_v<V> && !std::is_same_v<V, bool>) :
+    std::is_same_v<T, V>)));
+
+/*
+ * Key of parameter declared in an event schema, the key and the type of value are encoded at compile time.
+ * Type of value can be bool, intx_t, uintx_t, float, double, std::string or std::vector of them.
+ */
+template<const char* key, typename T>
+class HiSysEventSchemaKey {
+public:
+    using ValueType = T;
+    using ItemType = typename SchemaTypeTraits<T>::ItemType;
+
+    static constexpr bool IS_ARRAY = SchemaTypeTraits<T>::IS_ARRAY;
+    static constexpr std::string_view KEY { key };
+
+    static_assert(isSchemaScalarType<ItemType>, "type of parameter is not supported by event schema");
+    static_assert(StringFilter::IsValidConstName(KEY, MAX_PARAM_NAME_LENGTH), "key of parameter is invalid");
+
+    static constexpr auto ENCODED_KEY = Encoded::ParamEncoder::ConstKeyEncoded<
+        std::conditional_t<std::is_same_v<ItemType, std::string>, Encoded::EscapedString, ItemType>,
+        IS_ARRAY, KEY.length()>(KEY);
+};
+
+/*
+ * Event with domain, name, type and keys of parameters declared at compile time, which are validated
+ * by static assertion, and only the values of parameters are encoded while writing, eg.
+ *
+ *     static constexpr char EVENT_NAME[] = "APP_CRASH";
+ *     static constexpr char KEY_PID[] = "PID";
+ *     static constexpr char KEY_MSG[] = "MSG";
+ *     using AppCrashEvent = HiSysEventSchema<HiSysEvent::Domain::AAFWK, EVENT_NAME, HiSysEvent::EventType::FAULT,
+ *         HiSysEventSchemaKey<KEY_PID, int32_t>, HiSysEventSchemaKey<KEY_MSG, std::string>>;
+ *     HiSysEventSchemaWrite(AppCrashEvent, pid, msg);
+ */
+template<const char* domain, const char* eventName, HiSysEvent::EventType type, typename... Keys>
+class HiSysEventSchema {
+public:
+    static_assert(StringFilter::IsValidConstName(domain, MAX_DOMAIN_LENGTH), "domain of event is invalid");
+    static_assert(StringFilter::IsValidConstName(eventName, MAX_EVENT_NAME_LENGTH), "name of event is invalid");
+    static_assert(sizeof...(Keys) <= MAX_PARAM_NUMBER, "too many parameters in event schema");
+
+    /**
+     * @brief write system event with values of parameters in the order of keys declared, which is called by
+     *     macro HiSysEventSchemaWrite with the record of the call site.
+     * @param record  record of the call site, by which the events are limited and aggregated.
+     * @param func    function of the call site.
+     * @return 0 means success,
+     *     greater than 0 also means success but with some data ignored,
+     *     less than 0 means failure.
+     */
+    template<typename... Values>
+    static int Write(CallSiteRecord& record, const char* func, const Values&... values)
+    {
+        static_assert(sizeof...(Values) == sizeof...(Keys), "count of values mismatches with the schema");
+        static_assert((IsCompatibleValue<typename Keys::ValueType, Values>() && ...),
+            "type of value mismatches with the schema");
+        if constexpr (isMasked<domain>) {
+            return ERR_DOMAIN_MASKED;
+        } else {
+            return HiSysEvent::WriteAtCallSite<true>(func, 0, &record, std::string(domain), std::string(eventName),
+                type, [&values...] (HiSysEvent::EventBase& eventBase) {
+                    (AppendValue<Keys>(eventBase, values), ...);
+                });
+        }
+    }
+
+private:
+    template<typename T, typename V>
+    static constexpr bool IsCompatibleValue()
+    {
+        if constexpr (SchemaTypeTraits<T>::IS_ARRAY) {
+            return std::is_same_v<T, V>;
+        } else {
+            return isSchemaCompatibleType<T, V>;
+        }
+    }
+
+    template<typename Key, typename V>
+    static void AppendValue(HiSysEvent::EventBase& eventBase, const V& value)
+    {
+        using T = typename Key::ValueType;
+        auto& encodedKey = Key::ENCODED_KEY;
+        if constexpr (Key::IS_ARRAY) {
+            (void)HiSysEvent::IsWarnAndUpdate(HiSysEvent::CheckArraySize(value.size()), eventBase);
+            if constexpr (std::is_same_v<typename Key::ItemType, std::string>) {
+                for (auto& item : value) {
+                    (void)HiSysEvent::IsWarnAndUpdate(HiSysEvent::CheckValue(item), eventBase);
+                }
+            }
+            eventBase.AppendEncodedKeyParam(encodedKey.data(), encodedKey.size(), [&value] (Encoded::RawData& data) {
+                using ItemType = typename Key::ItemType;
+                if constexpr (std::is_same_v<ItemType, std::string>) {
+                    return Encoded::ParamEncoder::ArrayValueEncoded<Encoded::EscapedString>(data, value.begin(),
+                        value.size(), [] (const std::string& item) {
+                            return Encoded::EscapedString { item.c_str(), item.length() };
+                        });
+                } else {
+                    return Encoded::ParamEncoder::ArrayValueEncoded<ItemType>(data, value.begin(), value.size());
+                }
+            });
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            std::string_view str = value;
+            (void)HiSysEvent::IsWarnAndUpdate(HiSysEvent::CheckValueLength(str.length()), eventBase);
+            eventBase.AppendEncodedKeyParam(encodedKey.data(), encodedKey.size(), [str] (Encoded::RawData& data) {
+                return Encoded::ParamEncoder::ValueEncoded(data, Encoded::EscapedString { str.data(), str.length() });
+            });
+        } else {
+            eventBase.AppendEncodedKeyNumericParam<T>(encodedKey.data(), encodedKey.size(), Key::KEY.length(),
+                static_cast<T>(value));
+        }
+    }
+};
+
+/**
+ * @brief Macro interface for writing system event declared by schema.
+ * @param Schema  type of the event schema, eg. AppCrashEvent.
+ * @return 0 means success,
+ *     greater than 0 also means success but with some data ignored,
+ *     less than 0 means failure.
+ */
+#define HiSysEventSchemaWrite(Schema, ...) \
+({ \
+    static OHOS::HiviewDFX::CallSiteRecord hiSysEventSchemaCallSiteRecord2026___ { 0 }; \
+    Schema::Write(hiSysEventSchemaCallSiteRecord2026___, __FUNCTION__, ##__VA_ARGS__); \
+})
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_SCHEMA_H
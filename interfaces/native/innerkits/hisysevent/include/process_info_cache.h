@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_PROCESS_INFO_CACHE_H
+#define HISYSEVENT_PROCESS_INFO_CACHE_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace HiviewDFX {
+class ProcessInfoCache {
+public:
+    /*
+     * The pid is cached for the whole process and the tid is cached for each thread, both of them
+     * are dropped in the child process after fork.
+     */
+    static uint32_t GetPid();
+    static uint32_t GetTid();
+
+    /*
+     * The index of time zone is recalculated only if the global variable timezone has been changed
+     * by tzset.
+     */
+    static uint8_t GetTimeZoneIndex();
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_PROCESS_INFO_CACHE_H
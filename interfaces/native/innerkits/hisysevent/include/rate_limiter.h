@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_RATE_LIMITER_H
+#define HISYSEVENT_RATE_LIMITER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "raw_data.h"
+#include "write_option_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr uint32_t MAX_CALL_SITE_BUCKET_CNT = 4096;
+static constexpr uint32_t MAX_DOMAIN_BUCKET_CNT = 256;
+
+struct RateBudget {
+    uint32_t eventRate = 0;   // count of events refilled per second, 0 means the count is not limited
+    uint32_t eventBurst = 0;  // max count of events written at once, 0 means the same as the rate
+    uint32_t byteRate = 0;    // bytes refilled per second, 0 means the bytes are not limited
+    uint32_t byteBurst = 0;   // max bytes written at once, 0 means the same as the rate
+};
+
+/*
+ * Token buckets of events and bytes written by each call site, each domain and the whole process. Each bucket is
+ * kept as the time when it is refilled to full, so tokens are taken by compare-and-swap without any timer or lock,
+ * and a bucket refilled to full is the same as a new one, which is reused first once there are too many call sites.
+ * The budget of call sites takes the place of the period and threshold of WriteController once it is loaded.
+ */
+class RateLimiter {
+public:
+    static RateLimiter& GetInstance();
+
+    /*
+     * Load budgets from the config file, each line of which is "SCOPE [DOMAIN] EVENT_RATE EVENT_BURST
+     * [BYTE_RATE BYTE_BURST]", SCOPE is one of PROCESS, DOMAIN and CALL_SITE, DOMAIN "*" is the budget of each
+     * domain not given, and the text after "#" is a comment. Limiting is disabled if the path is empty.
+     * @return false if the file fails to open or any line is invalid, the budgets in use are kept.
+     */
+    bool LoadConfig(const std::string& configPath);
+    bool IsEnabled();
+    bool IsCallSiteLimited();
+
+    // take the tokens of the event from all buckets, nothing is taken if any bucket is short of tokens
+    bool IsWriteAllowed(const Encoded::RawData& rawData, uint64_t callSite);
+    void GetStats(RateLimitStats& stats) const;
+
+private:
+    RateLimiter() = default;
+    ~RateLimiter() = default;
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+private:
+    // cost of one token and max tokens owed in nanoseconds, the cost of bytes is computed by the rate
+    struct Limit {
+        uint64_t eventCost = 0;
+        uint64_t eventTolerance = 0;
+        uint32_t byteRate = 0;
+        uint64_t byteTolerance = 0;
+
+        bool IsLimited() const
+        {
+            return eventCost != 0 || byteRate != 0;
+        }
+    };
+
+    struct Config {
+        Limit process;
+        Limit callSite;
+        Limit anyDomain;
+        std::unordered_map<uint64_t, Limit> domains; // searched by hash of domain
+    };
+
+    // time when the tokens of events and bytes are refilled to full
+    struct Bucket {
+        std::atomic<uint64_t> eventTime { 0 };
+        std::atomic<uint64_t> byteTime { 0 };
+    };
+
+    // lock-free open-addressing table of buckets, the slot whose bucket is refilled to full first in the probe
+    // window is reused once the window is full, so that buckets are dropped without losing tokens if possible
+    template<size_t size>
+    class BucketTable {
+    public:
+        static constexpr size_t PROBE_LIMIT = 8;
+
+    public:
+        // find the bucket by the key, which is inserted if not found
+        Bucket& GetBucket(uint64_t key, uint64_t now);
+        uint32_t GetKeyCnt() const;
+        void Clear();
+
+    private:
+        static_assert((size & (size - 1)) == 0, "size of the table must be power of 2");
+
+        struct Slot {
+            std::atomic<uint64_t> key { 0 }; // 0 marks the empty slot
+            Bucket bucket;
+        };
+
+    private:
+        Slot slots_[size];
+    };
+
+private:
+    void LoadDefaultConfig();
+    void ReplaceConfig(std::unique_ptr<Config> config);
+
+    static Limit ToLimit(const RateBudget& budget);
+    static bool ConfigLineParsed(const std::string& line, Config& config);
+    static std::unique_ptr<Config> ConfigLoaded(const std::string& configPath);
+    static bool IsTaken(Bucket& bucket, const Limit& limit, uint64_t now, size_t bytes);
+    static void Return(Bucket& bucket, const Limit& limit, size_t bytes);
+
+private:
+    // configs loaded are never freed, since the replaced ones may be still read by the writing threads
+    std::atomic<const Config*> config_ { nullptr };
+    std::mutex configMutex_;
+    std::list<std::unique_ptr<Config>> loadedConfigs_;
+    std::once_flag defaultConfigFlag_;
+    Bucket processBucket_;
+    BucketTable<MAX_CALL_SITE_BUCKET_CNT> callSiteBuckets_;
+    BucketTable<MAX_DOMAIN_BUCKET_CNT> domainBuckets_;
+    std::atomic<uint64_t> passedCnt_ { 0 };
+    std::atomic<uint64_t> callSiteLimitedCnt_ { 0 };
+    std::atomic<uint64_t> domainLimitedCnt_ { 0 };
+    std::atomic<uint64_t> processLimitedCnt_ { 0 };
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_RATE_LIMITER_H
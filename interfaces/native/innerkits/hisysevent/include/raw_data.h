@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -28,17 +28,27 @@ class RawData {
 public:
     RawData();
     RawData(const RawData& data);
+    RawData(RawData&& data) noexcept;
     ~RawData();
 
 public:
     RawData& operator=(const RawData& data);
+    RawData& operator=(RawData&& data) noexcept;
 
 public:
     bool Append(uint8_t* data, size_t len);
+    // extend the data by len bytes which are left to be filled by the caller, nullptr is returned if failed
+    uint8_t* Extend(size_t len);
     bool Update(uint8_t* data, size_t len, size_t pos);
+    bool Reserve(size_t capacity);
     bool IsEmpty();
+    void Reset();
     uint8_t* GetData() const;
     size_t GetDataLength() const;
+    size_t GetCapacity() const;
+
+private:
+    bool Expand(size_t minCapacity);
 
 private:
     uint8_t* data_ = nullptr;
@@ -99,6 +99,14 @@ struct ParamValueType {
 };
 #pragma pack()
 
+/*
+ * Byte count of float or double array whose items are packed, the count of items is followed by the items
+ * as fixed width values of (1 << byte count) bytes instead of being encoded one by one with the length of
+ * each item, byte count of the array with items encoded one by one is 0.
+ */
+constexpr uint8_t PACKED_FLOAT_BYTE_CNT = 2; // 2: 4 bytes of float
+constexpr uint8_t PACKED_DOUBLE_BYTE_CNT = 3; // 3: 8 bytes of double
+
 enum ValueType: uint8_t {
     // Unknown value
     UNKNOWN = 0,
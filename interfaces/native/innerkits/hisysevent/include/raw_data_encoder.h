@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,8 @@
 #ifndef HISYSEVENT_INTERFACE_ENCODE_INCLUDE_RAW_DATA_ENCODER_H
 #define HISYSEVENT_INTERFACE_ENCODE_INCLUDE_RAW_DATA_ENCODER_H
 
+#include <algorithm>
+#include <cmath>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
@@ -45,11 +47,55 @@ inline static constexpr bool isUnsignedNum = std::is_same_v<std::decay_t<T>, std
     std::is_same_v<std::decay_t<T>, std::uint16_t> || std::is_same_v<std::decay_t<T>, std::uint32_t> ||
     std::is_same_v<std::decay_t<T>, uint64_t>;
 
+template<typename T>
+inline static constexpr bool isSignedNum = std::is_same_v<std::decay_t<T>, bool> ||
+    std::is_same_v<std::decay_t<T>, std::int8_t> || std::is_same_v<std::decay_t<T>, std::int16_t> ||
+    std::is_same_v<std::decay_t<T>, std::int32_t> || std::is_same_v<std::decay_t<T>, std::int64_t>;
+
+template<typename T>
+inline static constexpr bool isFloatingNum = std::is_same_v<std::decay_t<T>, float> ||
+    std::is_same_v<std::decay_t<T>, double>;
+
+// string value which is escaped by StringFilter while being encoded into the raw data
+struct EscapedString {
+    const char* str;
+    size_t len;
+};
+
 class RawDataEncoder {
 public:
     static bool ValueTypeEncoded(RawData& data, bool isArray, ValueType valueType,
         uint8_t count);
     static bool StringValueEncoded(RawData& data, const std::string& val);
+    static bool EscapedStringValueEncoded(RawData& data, const EscapedString& val);
+
+public:
+    // the encoders below run at compile time, their outputs are the same as the ones of runtime encoders
+    static constexpr size_t GetUnsignedVarintEncodedSize(uint64_t val)
+    {
+        // 5 bits in the tag byte and 7 bits in each of the other bytes, eg. 1 byte for 0~5 bits, 2 bytes for 6~12 bits
+        auto bitCnt = static_cast<size_t>(VARINT_MAX_BIT_CNT - __builtin_clzll(val | 1));
+        return 1 + (bitCnt + NON_TAG_BYTE_OFFSET - TAG_BYTE_OFFSET - 1) / NON_TAG_BYTE_OFFSET;
+    }
+
+    static constexpr size_t ConstUnsignedVarintEncoded(uint8_t* dest, const EncodeType type, uint64_t val)
+    {
+        size_t pos = 0;
+        dest[pos++] = static_cast<uint8_t>(static_cast<uint8_t>(type) << (TAG_BYTE_OFFSET + 1)) |
+            ((val < TAG_BYTE_BOUND) ? 0 : TAG_BYTE_BOUND) | static_cast<uint8_t>(val & TAG_BYTE_MASK);
+        for (val >>= TAG_BYTE_OFFSET; val > 0; val >>= NON_TAG_BYTE_OFFSET) {
+            dest[pos++] = ((val < NON_TAG_BYTE_BOUND) ? 0 : NON_TAG_BYTE_BOUND) |
+                static_cast<uint8_t>(val & NON_TAG_BYTE_MASK);
+        }
+        return pos;
+    }
+
+    // bit fields of struct ParamValueType are allocated from the least significant bit
+    static constexpr uint8_t ConstValueTypeEncoded(bool isArray, ValueType valueType, uint8_t count)
+    {
+        // 5: 1 + 4
+        return static_cast<uint8_t>((isArray ? 1 : 0) | (static_cast<uint8_t>(valueType) << 1) | (count << 5));
+    }
 
 public:
     // uintx_t -> uint64_t
@@ -59,20 +105,12 @@ public:
         if constexpr (!isUnsignedNum<T>) {
             return false;
         }
-        uint8_t cpyVal = EncodedTag(static_cast<uint8_t>(type)) | ((val < TAG_BYTE_BOUND) ? 0 : TAG_BYTE_BOUND) |
-            static_cast<uint8_t>(val & TAG_BYTE_MASK);
-        if (!data.Append(reinterpret_cast<uint8_t*>(&cpyVal), 1)) {
+        size_t size = GetUnsignedVarintEncodedSize(val);
+        uint8_t* dest = data.Extend(size);
+        if (dest == nullptr) {
             return false;
         }
-        val >>= TAG_BYTE_OFFSET;
-        while (val > 0) {
-            cpyVal = ((val < NON_TAG_BYTE_BOUND) ? 0 : NON_TAG_BYTE_BOUND) |
-                static_cast<uint8_t>(val & NON_TAG_BYTE_MASK);
-            if (!data.Append(reinterpret_cast<uint8_t*>(&cpyVal), 1)) {
-                return false;
-            }
-            val >>= NON_TAG_BYTE_OFFSET;
-        }
+        UnsignedVarintRawEncoded(dest, size, 0, ConstEncodedTag(type), val);
         return true;
     }
 
@@ -80,11 +118,34 @@ public:
     template<typename T>
     static bool SignedVarintEncoded(RawData& data, const EncodeType type, T val)
     {
-        int64_t valInt64 = static_cast<int64_t>(val);
-        // zigzag encode
-        uint64_t signMask = (val >= 0) ? 0 : std::numeric_limits<uint64_t>::max();
-        uint64_t uValInt64 = (static_cast<uint64_t>(valInt64) << 1) ^ signMask;
-        return UnsignedVarintEncoded(data, type, uValInt64);
+        return UnsignedVarintEncoded(data, type, ZigzagEncoded(static_cast<int64_t>(val)));
+    }
+
+    /*
+     * Items of uintx_t, intx_t or bool array are encoded as varints together, the raw data is extended once by
+     * the total encoded size, and the output is the same as encoding the items one by one.
+     */
+    template<typename T, typename Iter>
+    static bool VarintArrayEncoded(RawData& data, const EncodeType type, Iter begin, size_t cnt)
+    {
+        size_t totalSize = 0;
+        Iter iter = begin;
+        for (size_t index = 0; index < cnt; ++index, ++iter) {
+            totalSize += GetUnsignedVarintEncodedSize(GetVarint<T>(*iter));
+        }
+        uint8_t* dest = data.Extend(totalSize);
+        if (dest == nullptr) {
+            return false;
+        }
+        uint8_t tag = ConstEncodedTag(type);
+        uint8_t* end = dest + totalSize;
+        for (size_t index = 0; index < cnt; ++index, ++begin) {
+            uint64_t val = GetVarint<T>(*begin);
+            size_t size = GetUnsignedVarintEncodedSize(val);
+            UnsignedVarintRawEncoded(dest, size, static_cast<size_t>(end - dest), tag, val);
+            dest += size;
+        }
+        return true;
     }
 
     // float, double => double
@@ -101,10 +162,99 @@ public:
         return true;
     }
 
+    /*
+     * Items of float or double array are copied into the raw data as fixed width values in host byte order,
+     * same as FloatingNumberEncoded, and the items which are not finite are encoded as 0.
+     */
+    template<typename T, typename Iter>
+    static bool PackedFloatingArrayEncoded(RawData& data, Iter begin, size_t cnt)
+    {
+        if (!UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, cnt)) {
+            return false;
+        }
+        if constexpr (std::is_same_v<Iter, const T*> || std::is_same_v<Iter, T*> ||
+            std::is_same_v<Iter, typename std::vector<T>::const_iterator> ||
+            std::is_same_v<Iter, typename std::vector<T>::iterator>) {
+            // items in the memory of caller are copied at once if all of them are finite
+            const T* items = (cnt > 0) ? &(*begin) : nullptr;
+            if (items != nullptr && std::all_of(items, items + cnt, [] (T item) { return std::isfinite(item); })) {
+                return data.Append(reinterpret_cast<uint8_t*>(const_cast<T*>(items)), cnt * sizeof(T));
+            }
+        }
+        for (size_t index = 0; index < cnt; ++index, ++begin) {
+            T val = static_cast<T>(*begin);
+            val = std::isfinite(val) ? val : static_cast<T>(0);
+            if (!data.Append(reinterpret_cast<uint8_t*>(&val), sizeof(T))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * Packed arrays should be enabled only if the receiver is able to decode them, arrays of float and double
+     * are encoded item by item by default.
+     */
+    static void SetPackedArrayEnabled(bool enabled);
+    static bool IsPackedArrayEnabled();
+
 private:
     static uint8_t EncodedTag(uint8_t type);
 
+    static constexpr uint8_t ConstEncodedTag(const EncodeType type)
+    {
+        return static_cast<uint8_t>(static_cast<uint8_t>(type) << (TAG_BYTE_OFFSET + 1));
+    }
+
+    static constexpr uint64_t ZigzagEncoded(int64_t val)
+    {
+        uint64_t signMask = (val >= 0) ? 0 : std::numeric_limits<uint64_t>::max();
+        return (static_cast<uint64_t>(val) << 1) ^ signMask;
+    }
+
+    template<typename T, typename V>
+    static uint64_t GetVarint(const V& item)
+    {
+        if constexpr (isUnsignedNum<T>) {
+            return static_cast<uint64_t>(static_cast<T>(item));
+        } else {
+            return ZigzagEncoded(static_cast<int64_t>(static_cast<T>(item)));
+        }
+    }
+
+    /*
+     * Write the varint of size bytes into dest. If there is room for a whole word after the tag byte, the 7 bits
+     * groups are spread into the bytes of a word by masks and shifts and the word is stored at once instead of
+     * being stored byte by byte, the bytes beyond the varint are overwritten by the next one.
+     */
+    static void UnsignedVarintRawEncoded(uint8_t* dest, size_t size, size_t room, uint8_t tag, uint64_t val)
+    {
+        dest[0] = tag | ((size > 1) ? TAG_BYTE_BOUND : 0) | static_cast<uint8_t>(val & TAG_BYTE_MASK);
+        val >>= TAG_BYTE_OFFSET;
+        if (size > 1 && room > VARINT_WORD_SIZE + 1) {
+            uint64_t word = (val & 0x000000000FFFFFFFULL) | ((val & 0x00FFFFFFF0000000ULL) << 4); // 4: 28 -> 32 bits
+            word = (word & 0x00003FFF00003FFFULL) | ((word & 0x0FFFC0000FFFC000ULL) << 2); // 2: 14 -> 16 bits
+            word = (word & 0x007F007F007F007FULL) | ((word & 0x3F803F803F803F80ULL) << 1); // 1: 7 -> 8 bits
+            word |= (size > VARINT_WORD_SIZE + 1) ? VARINT_WORD_CONTINUATION_BITS :
+                (VARINT_WORD_CONTINUATION_BITS & ((1ULL << ((size - 2) * BIT_CNT_PER_BYTE)) - 1)); // 2: tag and last
+            for (size_t index = 0; index < VARINT_WORD_SIZE; ++index) {
+                dest[index + 1] = static_cast<uint8_t>(word >> (index * BIT_CNT_PER_BYTE));
+            }
+            dest[VARINT_WORD_SIZE + 1] = static_cast<uint8_t>(val >> (VARINT_WORD_SIZE * NON_TAG_BYTE_OFFSET));
+            return;
+        }
+        for (size_t pos = 1; pos < size; ++pos) {
+            dest[pos] = ((pos + 1 < size) ? NON_TAG_BYTE_BOUND : 0) | static_cast<uint8_t>(val & NON_TAG_BYTE_MASK);
+            val >>= NON_TAG_BYTE_OFFSET;
+        }
+    }
+
 private:
+    static constexpr size_t BIT_CNT_PER_BYTE = 8;
+    static constexpr size_t VARINT_MAX_BIT_CNT = 64;
+    static constexpr size_t VARINT_WORD_SIZE = sizeof(uint64_t);
+    static constexpr uint64_t VARINT_WORD_CONTINUATION_BITS = 0x8080808080808080ULL;
+
     static constexpr unsigned int TAG_BYTE_OFFSET = 5;
     static constexpr unsigned int TAG_BYTE_BOUND  = (1 << TAG_BYTE_OFFSET);
     static constexpr unsigned int TAG_BYTE_MASK = (TAG_BYTE_BOUND - 1);
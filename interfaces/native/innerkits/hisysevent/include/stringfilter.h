@@ -16,7 +16,9 @@
 #ifndef HISYSEVENT_STRING_FILTER_H
 #define HISYSEVENT_STRING_FILTER_H
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -26,10 +28,36 @@ public:
     ~StringFilter() {}
     // Transform special char to escaped form ("lookup table" method)
     std::string EscapeToRaw(const std::string &text);
+    // Count of bytes the text takes after being escaped
+    size_t GetEscapedLength(const char* text, size_t len);
+    // Escape the text into dest which should be sized by GetEscapedLength, count of bytes wrote is returned
+    size_t EscapeToRaw(const char* text, size_t len, char* dest, size_t destLen);
     // Check lexical ("finite state machine" method)
     bool IsValidName(const std::string &text, unsigned int maxSize);
+    // Check lexical of names known at compile time, the result is the same as the one of IsValidName
+    static constexpr bool IsValidConstName(std::string_view text, unsigned int maxSize)
+    {
+        if (text.empty() || text.length() > maxSize) {
+            return false;
+        }
+        auto isLetter = [] (char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        };
+        if (!isLetter(text[0])) {
+            return false;
+        }
+        for (size_t i = 1; i < text.length(); ++i) {
+            if (!isLetter(text[i]) && !(text[i] >= '0' && text[i] <= '9') && (text[i] != '_')) {
+                return false;
+            }
+        }
+        return true;
+    }
     static StringFilter& GetInstance();
 
+private:
+    static size_t GetEscapedCharLength(unsigned char c);
+
 private:
     static constexpr int CHAR_RANGE = 128;
     static constexpr int MAP_STR_LEN = 3;
@@ -16,10 +16,12 @@
 #ifndef HISYSEVENT_TRANSPORT_H
 #define HISYSEVENT_TRANSPORT_H
 
-#include <list>
+#include <atomic>
 #include <mutex>
+#include <semaphore.h>
 #include <string>
 
+#include "event_socket_factory.h"
 #include "raw_data.h"
 
 namespace OHOS {
@@ -29,9 +31,16 @@ class Transport {
 public:
     static Transport& GetInstance();
     int SendData(RawData& rawData);
+    int SendData(RawData& rawData, const EventRoute& route);
+    int Flush();
+    void SetBatchMode(bool enabled, uint32_t batchSize, uint32_t latencyBudget);
+    bool SetSpool(bool enabled, const std::string& path, uint32_t capacity);
+
+public:
+    static constexpr uint32_t RETRY_QUEUE_SIZE = 10;
 
 private:
-    Transport() {}
+    Transport();
     ~Transport() {}
     Transport& operator=(const Transport&) = delete;
     Transport(const Transport&) = delete;
@@ -40,16 +49,30 @@ private:
 
 private:
     void AddFailedData(RawData& rawData);
-    void InitRecvBuffer(int socketId);
+    int FlushBatch();
+    void FlushExpiredBatches();
     void RetrySendFailedData();
-    int SendToHiSysEventDataSource(RawData& rawData);
+    void RetrySendSpooledData(RawData& rawData);
+    int SendToHiSysEventDataSource(RawData& rawData, const EventSocket& serverAddr);
+    int StageData(RawData& rawData, const EventSocket& serverAddr);
+    bool StartRetrier();
+    void WakeUpRetrier();
+    void WaitForRetry(bool isTimed);
+
+private:
+    static void* RetryInBackground(void* arg);
+    static void ResetRetrierAfterFork();
 
 private:
     static Transport instance_;
-    static constexpr std::size_t RETRY_QUEUE_SIZE = 10;
     static constexpr int RETRY_TIMES = 3;
+    static constexpr int MAX_RETRY_ROUNDS = 3;
+    static constexpr uint64_t RETRY_INTERVAL = 1; // 1s
+    std::atomic<bool> hasFailedData_ { false };
+    std::atomic<bool> isRetrierStarted_ { false };
+    std::atomic<bool> isRetrierSleeping_ { false };
     std::mutex mutex_;
-    std::list<RawData> retryDataList_;
+    sem_t wakeUpSem_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
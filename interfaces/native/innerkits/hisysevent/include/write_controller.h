@@ -16,6 +16,7 @@
 #ifndef WRITE_CONTROLLER_H
 #define WRITE_CONTROLLER_H
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <sys/time.h>
@@ -38,7 +39,10 @@ using CallerInfo = struct {
     uint64_t timeStamp;
 };
 
-class EventWroteLruCache;
+// state of writing events at one call site, the timestamp and count are packed to be updated atomically
+using CallSiteRecord = std::atomic<uint64_t>;
+
+class EventWroteRecordTable;
 
 class WriteController {
 public:
@@ -47,9 +51,11 @@ public:
         const CallerInfo& callerInfo);
     static uint64_t CheckLimitWritingEvent(const ControlParam& param, const char* domain, const char* eventName,
         const char* func, int64_t line);
+    static uint64_t CheckLimitWritingEvent(const ControlParam& param, const char* domain, const char* eventName,
+        const char* func, CallSiteRecord& record);
 
 private:
-    static EventWroteLruCache eventWroteLruCache_;
+    static EventWroteRecordTable eventWroteRecordTable_;
 };
 } // HiviewDFX
 } // OHOS
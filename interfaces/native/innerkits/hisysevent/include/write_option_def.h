@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_WRITE_OPTION_DEF_H
+#define HISYSEVENT_WRITE_OPTION_DEF_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// options and counters of the modes of writing events, which are set and read through HiSysEvent
+namespace OHOS {
+namespace HiviewDFX {
+static constexpr uint32_t DEFAULT_ASYNC_QUEUE_DEPTH = 256;
+static constexpr uint32_t MAX_ASYNC_QUEUE_DEPTH = 4096;
+static constexpr uint32_t MAX_PRIORITY_LANE_CNT = 4;
+static constexpr uint32_t MAX_ASYNC_BLOCK_TIME = 1000; // 1000ms
+
+enum class AsyncDropPolicy {
+    DROP_NEWEST = 0,    // drop the event to submit if the queue is full
+    DROP_OLDEST = 1,    // drop the earliest queued event to make room for the event to submit
+    BLOCK = 2,          // wait until the background sender makes room for the event to submit, and drop the
+                        // event if no room is made in MAX_ASYNC_BLOCK_TIME
+};
+
+struct PriorityLaneConfig {
+    uint32_t queueDepth = DEFAULT_ASYNC_QUEUE_DEPTH;
+    AsyncDropPolicy policy = AsyncDropPolicy::DROP_NEWEST;
+    // "DOMAIN NAME [TYPE ...]" of events sent by the lane, NAME "*" means all events of the domain
+    std::vector<std::string> events;
+};
+
+struct PriorityLaneStats {
+    uint64_t sentCnt = 0;           // count of events sent
+    uint64_t failedCnt = 0;         // count of events failed to send, including those failing fast while the
+                                    // circuit is open, which are left to be retried if not dropped by the retrier
+    uint64_t droppedCnt = 0;        // count of events dropped because the queue is full or out of memory
+    uint32_t queueHighWaterMark = 0; // max count of events queued
+};
+
+static constexpr uint32_t DEFAULT_CIRCUIT_FAILURE_THRESHOLD = 8;
+static constexpr uint32_t DEFAULT_CIRCUIT_MAX_BACKOFF = 5000; // 5s
+
+enum class CircuitState {
+    CLOSED = 0,     // events are sent as usual
+    OPEN = 1,       // events fail fast without being sent, and are left to be retried
+    HALF_OPEN = 2,  // one event is sent to probe whether hiview is available again
+};
+
+struct CircuitBreakerStats {
+    CircuitState state = CircuitState::CLOSED;
+    uint64_t openedCnt = 0;         // count of transitions to OPEN
+    uint64_t closedCnt = 0;         // count of recoveries to CLOSED
+    uint64_t probeCnt = 0;          // count of probes sent
+    uint64_t fastFailedCnt = 0;     // count of events failed fast without being sent
+    uint64_t lastTransitionTime = 0; // monotonic milliseconds of the last transition
+    uint32_t backoff = 0;           // milliseconds from the last transition to OPEN to the next probe
+};
+
+static constexpr uint32_t MIN_SPOOL_CAPACITY = 64 * 1024; // 64K
+static constexpr uint32_t DEFAULT_SPOOL_CAPACITY = 1024 * 1024; // 1M
+static constexpr uint32_t MAX_SPOOL_CAPACITY = 16 * 1024 * 1024; // 16M
+
+struct EventSpoolStats {
+    bool isOpened = false;
+    uint32_t capacity = 0;      // bytes of the file used to store events
+    uint32_t usedBytes = 0;     // bytes of events not sent yet
+    uint64_t pendingCnt = 0;    // count of events not sent yet
+    uint64_t spooledCnt = 0;    // count of events appended since the spool is opened
+    uint64_t drainedCnt = 0;    // count of events sent from the spool
+    uint64_t recoveredCnt = 0;  // count of events left by the former process found while opening
+    uint64_t droppedCnt = 0;    // count of events dropped since the spool is full
+    uint64_t tornCnt = 0;       // count of records found torn or corrupted while opening
+};
+
+static constexpr uint32_t MIN_AGGREGATION_WINDOW = 100; // 100ms
+static constexpr uint32_t DEFAULT_AGGREGATION_WINDOW = 5000; // 5s, same as HISYSEVENT_DEFAULT_PERIOD
+
+struct AggregationStats {
+    uint64_t sentCnt = 0;       // count of events sent as the first one of their groups in the window
+    uint64_t foldedCnt = 0;     // count of events folded into summaries instead of being sent
+    uint64_t summaryCnt = 0;    // count of summaries sent
+    uint64_t discardedCnt = 0;  // count of events discarded since there are too many groups in the window
+};
+
+struct RateLimitStats {
+    bool isEnabled = false;
+    uint64_t passedCnt = 0;             // count of events within all budgets
+    uint64_t callSiteLimitedCnt = 0;    // count of events discarded by the budget of the call site
+    uint64_t domainLimitedCnt = 0;      // count of events discarded by the budget of the domain
+    uint64_t processLimitedCnt = 0;     // count of events discarded by the budget of the process
+    uint32_t callSiteCnt = 0;           // count of call sites tracked now
+};
+
+static constexpr uint32_t FULL_SAMPLING_RATE = 1000000; // rates of sampling are in parts per million
+static constexpr uint32_t MAX_SAMPLING_POLICY_CNT = 64;
+
+enum class SamplingMode {
+    SAMPLE_RANDOM = 0,          // each event is kept randomly by the rate
+    SAMPLE_DETERMINISTIC = 1,   // events are kept evenly by the rate in the order they are written, eg. 1 of 100
+    SAMPLE_BY_TRACE = 2,        // events of one trace are kept or dropped together by the hash of trace id
+};
+
+struct SamplingPolicy {
+    uint32_t rate = FULL_SAMPLING_RATE; // parts per million of events kept
+    SamplingMode mode = SamplingMode::SAMPLE_RANDOM;
+    // "DOMAIN NAME" of events sampled by the policy, NAME "*" means all events of the domain
+    std::vector<std::string> events;
+};
+
+struct SamplingStats {
+    uint64_t keptCnt = 0;       // count of events kept
+    uint64_t droppedCnt = 0;    // count of events dropped before being encoded
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_WRITE_OPTION_DEF_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "process_info_cache.h"
+
+#include <atomic>
+#include <ctime>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "raw_data_base_def.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr uint32_t INVALID_ID = 0;
+
+std::atomic<uint32_t> g_pid { INVALID_ID };
+thread_local uint32_t g_tid = INVALID_ID;
+thread_local bool g_isTimeZoneParsed = false;
+thread_local long g_timeZone = 0;
+thread_local uint8_t g_timeZoneIndex = 0;
+
+void OnChildForked()
+{
+    // only the thread calling fork survives in the child process and this handler runs on it
+    g_pid.store(INVALID_ID, std::memory_order_relaxed);
+    g_tid = INVALID_ID;
+}
+
+void InitForkHandler()
+{
+    static bool isInited = [] {
+        return pthread_atfork(nullptr, nullptr, OnChildForked) == 0;
+    }();
+    (void)isInited;
+}
+}
+
+uint32_t ProcessInfoCache::GetPid()
+{
+    uint32_t pid = g_pid.load(std::memory_order_relaxed);
+    if (pid == INVALID_ID) {
+        InitForkHandler();
+        pid = static_cast<uint32_t>(getprocpid());
+        g_pid.store(pid, std::memory_order_relaxed);
+    }
+    return pid;
+}
+
+uint32_t ProcessInfoCache::GetTid()
+{
+    if (g_tid == INVALID_ID) {
+        InitForkHandler();
+        g_tid = static_cast<uint32_t>(getproctid());
+    }
+    return g_tid;
+}
+
+uint8_t ProcessInfoCache::GetTimeZoneIndex()
+{
+    long curTimeZone = timezone;
+    if (!g_isTimeZoneParsed || curTimeZone != g_timeZone) {
+        g_timeZoneIndex = static_cast<uint8_t>(Encoded::ParseTimeZone(curTimeZone));
+        g_timeZone = curTimeZone;
+        g_isTimeZoneParsed = true;
+    }
+    return g_timeZoneIndex;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
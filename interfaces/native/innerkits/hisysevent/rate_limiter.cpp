@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rate_limiter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <pthread.h>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "def.h"
+#include "event_rule_table.h"
+#include "hilog/log.h"
+#include "raw_data_base_def.h"
+#include "stringfilter.h"
+
+#undef LOG_DOMAIN
+#define LOG_DOMAIN 0xD002D08
+
+#undef LOG_TAG
+#define LOG_TAG "HISYSEVENT_RATE_LIMITER"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr char RATE_LIMIT_CONFIG[] = "/system/etc/hiview/hisysevent_rate_limit.cfg";
+constexpr char COMMENT_MARK = '#';
+constexpr char PROCESS_SCOPE[] = "PROCESS";
+constexpr char DOMAIN_SCOPE[] = "DOMAIN";
+constexpr char CALL_SITE_SCOPE[] = "CALL_SITE";
+constexpr char ANY_DOMAIN[] = "*";
+constexpr size_t EVENT_BUDGET_CNT = 2; // EVENT_RATE EVENT_BURST
+constexpr size_t FULL_BUDGET_CNT = 4; // EVENT_RATE EVENT_BURST BYTE_RATE BYTE_BURST
+constexpr size_t MAX_BUDGET_DIGITS = 10;
+constexpr uint64_t NANOS_PER_SEC = 1000000000;
+constexpr uint64_t EMPTY_KEY = 0;
+constexpr uint64_t KEY_HASH_FACTOR = 0x9e3779b97f4a7c15ULL; // spread the aligned addresses of call sites
+
+inline uint64_t GetMonotonicTimeNanos()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// generic cell rate algorithm, the time when the bucket is full again is pushed back by the cost of the event
+bool IsTokenTaken(std::atomic<uint64_t>& fullTime, uint64_t now, uint64_t cost, uint64_t tolerance)
+{
+    uint64_t oldTime = fullTime.load(std::memory_order_relaxed);
+    uint64_t newTime = 0;
+    do {
+        newTime = std::max(oldTime, now) + cost;
+        if (newTime - now > tolerance) {
+            return false;
+        }
+    } while (!fullTime.compare_exchange_weak(oldTime, newTime, std::memory_order_relaxed));
+    return true;
+}
+
+// the time is never earlier than 0 even if the bucket is reset by new budgets before the tokens are returned
+void ReturnToken(std::atomic<uint64_t>& fullTime, uint64_t cost)
+{
+    uint64_t oldTime = fullTime.load(std::memory_order_relaxed);
+    while (!fullTime.compare_exchange_weak(oldTime, (oldTime > cost) ? (oldTime - cost) : 0,
+        std::memory_order_relaxed)) {}
+}
+
+inline uint64_t GetByteCost(size_t bytes, uint32_t byteRate)
+{
+    return static_cast<uint64_t>(bytes) * NANOS_PER_SEC / byteRate;
+}
+
+bool BudgetValueParsed(const std::string& token, uint32_t& value)
+{
+    if (token.empty() || token.length() > MAX_BUDGET_DIGITS || !std::all_of(token.begin(), token.end(),
+        [] (char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        return false;
+    }
+    uint64_t parsedValue = std::stoull(token);
+    if (parsedValue > UINT32_MAX) {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsedValue);
+    return true;
+}
+
+inline uint64_t GetDomainHash(std::string_view domain)
+{
+    return EventRuleTable::GetEventHash(domain, EventRuleTable::ANY_EVENT_NAME);
+}
+}
+
+RateLimiter& RateLimiter::GetInstance()
+{
+    static RateLimiter instance;
+    // the mutex must not be kept locked in the child process by the thread which does not exist there
+    static const int atForkRet = pthread_atfork([] { instance.configMutex_.lock(); },
+        [] { instance.configMutex_.unlock(); }, [] { instance.configMutex_.unlock(); });
+    (void)atForkRet;
+    return instance;
+}
+
+bool RateLimiter::LoadConfig(const std::string& configPath)
+{
+    // the default config is loaded first, so that it never replaces the one loaded here
+    LoadDefaultConfig();
+    if (configPath.empty()) {
+        ReplaceConfig(nullptr);
+        return true;
+    }
+    auto config = ConfigLoaded(configPath);
+    if (config == nullptr) {
+        HILOG_WARN(LOG_CORE, "failed to load budgets of writing events, keep the ones in use");
+        return false;
+    }
+    ReplaceConfig(std::move(config));
+    return true;
+}
+
+bool RateLimiter::IsEnabled()
+{
+    LoadDefaultConfig();
+    return config_.load(std::memory_order_acquire) != nullptr;
+}
+
+bool RateLimiter::IsCallSiteLimited()
+{
+    LoadDefaultConfig();
+    auto config = config_.load(std::memory_order_acquire);
+    return config != nullptr && config->callSite.IsLimited();
+}
+
+bool RateLimiter::IsWriteAllowed(const Encoded::RawData& rawData, uint64_t callSite)
+{
+    auto config = config_.load(std::memory_order_acquire);
+    if (config == nullptr || rawData.GetDataLength() < sizeof(int32_t) + sizeof(struct Encoded::HiSysEventHeader)) {
+        return true;
+    }
+    auto header = reinterpret_cast<const struct Encoded::HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t));
+    uint64_t domainHash = GetDomainHash(std::string_view(header->domain,
+        strnlen(header->domain, sizeof(header->domain))));
+    auto domainIter = config->domains.find(domainHash);
+    const Limit& domainLimit = (domainIter == config->domains.end()) ? config->anyDomain : domainIter->second;
+    size_t bytes = rawData.GetDataLength();
+    uint64_t now = GetMonotonicTimeNanos();
+
+    // the call site is unknown if it is 0, eg. the event is written by js
+    Bucket* callSiteBucket = (callSite != 0 && config->callSite.IsLimited()) ?
+        &callSiteBuckets_.GetBucket(callSite, now) : nullptr;
+    if (callSiteBucket != nullptr && !IsTaken(*callSiteBucket, config->callSite, now, bytes)) {
+        callSiteLimitedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Bucket* domainBucket = domainLimit.IsLimited() ? &domainBuckets_.GetBucket(domainHash, now) : nullptr;
+    if (domainBucket != nullptr && !IsTaken(*domainBucket, domainLimit, now, bytes)) {
+        if (callSiteBucket != nullptr) {
+            Return(*callSiteBucket, config->callSite, bytes);
+        }
+        domainLimitedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!IsTaken(processBucket_, config->process, now, bytes)) {
+        if (callSiteBucket != nullptr) {
+            Return(*callSiteBucket, config->callSite, bytes);
+        }
+        if (domainBucket != nullptr) {
+            Return(*domainBucket, domainLimit, bytes);
+        }
+        processLimitedCnt_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    passedCnt_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void RateLimiter::GetStats(RateLimitStats& stats) const
+{
+    stats.isEnabled = config_.load(std::memory_order_acquire) != nullptr;
+    stats.passedCnt = passedCnt_.load(std::memory_order_relaxed);
+    stats.callSiteLimitedCnt = callSiteLimitedCnt_.load(std::memory_order_relaxed);
+    stats.domainLimitedCnt = domainLimitedCnt_.load(std::memory_order_relaxed);
+    stats.processLimitedCnt = processLimitedCnt_.load(std::memory_order_relaxed);
+    stats.callSiteCnt = callSiteBuckets_.GetKeyCnt();
+}
+
+void RateLimiter::LoadDefaultConfig()
+{
+    std::call_once(defaultConfigFlag_, [this] {
+        // nothing is limited if the config file does not exist
+        if (auto config = ConfigLoaded(RATE_LIMIT_CONFIG); config != nullptr) {
+            ReplaceConfig(std::move(config));
+        }
+    });
+}
+
+void RateLimiter::ReplaceConfig(std::unique_ptr<Config> config)
+{
+    std::lock_guard<std::mutex> lock(configMutex_);
+    // tokens are counted again by the new budgets, the ones taken meanwhile by the writing threads may be lost
+    callSiteBuckets_.Clear();
+    domainBuckets_.Clear();
+    processBucket_.eventTime.store(0, std::memory_order_relaxed);
+    processBucket_.byteTime.store(0, std::memory_order_relaxed);
+    config_.store(config.get(), std::memory_order_release);
+    if (config != nullptr) {
+        loadedConfigs_.push_back(std::move(config));
+    }
+}
+
+template<size_t size>
+RateLimiter::Bucket& RateLimiter::BucketTable<size>::GetBucket(uint64_t key, uint64_t now)
+{
+    key = (key == EMPTY_KEY) ? 1 : key; // 0 is reserved for empty slot
+    size_t index = static_cast<size_t>((key * KEY_HASH_FACTOR) >> (64 - __builtin_ctzll(size))); // 64: bits of key
+    Slot* fullestSlot = nullptr;
+    uint64_t fullestTime = UINT64_MAX;
+    for (size_t i = 0; i < PROBE_LIMIT; i++) {
+        auto& slot = slots_[(index + i) & (size - 1)];
+        auto slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == EMPTY_KEY &&
+            slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel)) {
+            return slot.bucket;
+        }
+        if (slotKey == key) {
+            return slot.bucket;
+        }
+        uint64_t fullTime = std::max(slot.bucket.eventTime.load(std::memory_order_relaxed),
+            slot.bucket.byteTime.load(std::memory_order_relaxed));
+        if (fullTime < fullestTime) {
+            fullestTime = fullTime;
+            fullestSlot = &slot;
+        }
+    }
+    // the bucket refilled to full is the same as a new one, or the one to be full first is reset
+    fullestSlot->key.store(key, std::memory_order_release);
+    if (fullestTime > now) {
+        fullestSlot->bucket.eventTime.store(0, std::memory_order_relaxed);
+        fullestSlot->bucket.byteTime.store(0, std::memory_order_relaxed);
+    }
+    return fullestSlot->bucket;
+}
+
+template<size_t size>
+uint32_t RateLimiter::BucketTable<size>::GetKeyCnt() const
+{
+    uint32_t keyCnt = 0;
+    for (const auto& slot : slots_) {
+        keyCnt += (slot.key.load(std::memory_order_relaxed) != EMPTY_KEY) ? 1 : 0;
+    }
+    return keyCnt;
+}
+
+template<size_t size>
+void RateLimiter::BucketTable<size>::Clear()
+{
+    for (auto& slot : slots_) {
+        slot.key.store(EMPTY_KEY, std::memory_order_relaxed);
+        slot.bucket.eventTime.store(0, std::memory_order_relaxed);
+        slot.bucket.byteTime.store(0, std::memory_order_relaxed);
+    }
+}
+
+RateLimiter::Limit RateLimiter::ToLimit(const RateBudget& budget)
+{
+    Limit limit;
+    if (budget.eventRate != 0) {
+        uint32_t eventBurst = (budget.eventBurst == 0) ? budget.eventRate : budget.eventBurst;
+        limit.eventCost = std::max<uint64_t>(NANOS_PER_SEC / budget.eventRate, 1);
+        limit.eventTolerance = limit.eventCost * eventBurst;
+    }
+    if (budget.byteRate != 0) {
+        uint32_t byteBurst = (budget.byteBurst == 0) ? budget.byteRate : budget.byteBurst;
+        limit.byteRate = budget.byteRate;
+        limit.byteTolerance = GetByteCost(byteBurst, budget.byteRate);
+    }
+    return limit;
+}
+
+bool RateLimiter::ConfigLineParsed(const std::string& line, Config& config)
+{
+    std::istringstream tokens(line.substr(0, line.find(COMMENT_MARK)));
+    std::string scope;
+    if (!(tokens >> scope)) {
+        return true; // empty line or comment
+    }
+    std::string domain;
+    if (scope == DOMAIN_SCOPE && (!(tokens >> domain) ||
+        (domain != ANY_DOMAIN && !StringFilter::GetInstance().IsValidName(domain, MAX_DOMAIN_LENGTH)))) {
+        return false;
+    }
+    std::vector<uint32_t> values;
+    for (std::string token; tokens >> token;) {
+        uint32_t value = 0;
+        if (!BudgetValueParsed(token, value)) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    if (values.size() != EVENT_BUDGET_CNT && values.size() != FULL_BUDGET_CNT) {
+        return false;
+    }
+    RateBudget budget = { values[0], values[1], 0, 0 }; // 0, 1: index of event rate and burst
+    if (values.size() == FULL_BUDGET_CNT) {
+        budget.byteRate = values[2]; // 2: index of byte rate
+        budget.byteBurst = values[3]; // 3: index of byte burst
+    }
+    if (scope == PROCESS_SCOPE) {
+        config.process = ToLimit(budget);
+    } else if (scope == CALL_SITE_SCOPE) {
+        config.callSite = ToLimit(budget);
+    } else if (scope == DOMAIN_SCOPE && domain == ANY_DOMAIN) {
+        config.anyDomain = ToLimit(budget);
+    } else if (scope == DOMAIN_SCOPE) {
+        config.domains[GetDomainHash(domain)] = ToLimit(budget);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<RateLimiter::Config> RateLimiter::ConfigLoaded(const std::string& configPath)
+{
+    std::ifstream fin(configPath);
+    if (!fin.is_open()) {
+        return nullptr;
+    }
+    auto config = std::make_unique<Config>();
+    size_t lineNo = 0;
+    for (std::string line; std::getline(fin, line);) {
+        ++lineNo;
+        if (!ConfigLineParsed(line, *config)) {
+            HILOG_WARN(LOG_CORE, "line %{public}zu of config of budgets is invalid", lineNo);
+            return nullptr;
+        }
+    }
+    return config;
+}
+
+bool RateLimiter::IsTaken(Bucket& bucket, const Limit& limit, uint64_t now, size_t bytes)
+{
+    if (limit.eventCost != 0 && !IsTokenTaken(bucket.eventTime, now, limit.eventCost, limit.eventTolerance)) {
+        return false;
+    }
+    if (limit.byteRate != 0 &&
+        !IsTokenTaken(bucket.byteTime, now, GetByteCost(bytes, limit.byteRate), limit.byteTolerance)) {
+        if (limit.eventCost != 0) {
+            ReturnToken(bucket.eventTime, limit.eventCost);
+        }
+        return false;
+    }
+    return true;
+}
+
+void RateLimiter::Return(Bucket& bucket, const Limit& limit, size_t bytes)
+{
+    if (limit.eventCost != 0) {
+        ReturnToken(bucket.eventTime, limit.eventCost);
+    }
+    if (limit.byteRate != 0) {
+        ReturnToken(bucket.byteTime, GetByteCost(bytes, limit.byteRate));
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
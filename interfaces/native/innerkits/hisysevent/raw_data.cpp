@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,7 @@
 
 #include <new>
 
+#include "def.h"
 #include "hilog/log.h"
 #include "securec.h"
 
@@ -31,6 +32,17 @@ namespace HiviewDFX {
 namespace Encoded {
 namespace {
 constexpr size_t EXPAND_BUF_SIZE = 128;
+
+// double the capacity at least to keep appending in amortized constant time, but stop at MAX_DATA_SIZE on the
+// way, so that the buffer of any valid event is never grown past the size kept by the event buffer cache
+size_t GetExpandedCapacity(size_t capacity, size_t minCapacity)
+{
+    size_t expandedCapacity = capacity * 2; // 2: growth factor
+    if (capacity < MAX_DATA_SIZE && expandedCapacity > MAX_DATA_SIZE) {
+        expandedCapacity = MAX_DATA_SIZE;
+    }
+    return (expandedCapacity < minCapacity) ? minCapacity : expandedCapacity;
+}
 }
 
 RawData::RawData()
@@ -69,6 +81,16 @@ RawData::RawData(const RawData& data)
     len_ = dataLen;
 }
 
+RawData::RawData(RawData&& data) noexcept
+{
+    data_ = data.data_;
+    len_ = data.len_;
+    capacity_ = data.capacity_;
+    data.data_ = nullptr;
+    data.len_ = 0;
+    data.capacity_ = 0;
+}
+
 RawData& RawData::operator=(const RawData& data)
 {
     if (this == &data) {
@@ -98,6 +120,23 @@ RawData& RawData::operator=(const RawData& data)
     return *this;
 }
 
+RawData& RawData::operator=(RawData&& data) noexcept
+{
+    if (this == &data) {
+        return *this;
+    }
+    if (data_ != nullptr) {
+        delete[] data_;
+    }
+    data_ = data.data_;
+    len_ = data.len_;
+    capacity_ = data.capacity_;
+    data.data_ = nullptr;
+    data.len_ = 0;
+    data.capacity_ = 0;
+    return *this;
+}
+
 RawData::~RawData()
 {
     if (data_ != nullptr) {
@@ -114,11 +153,32 @@ bool RawData::Append(uint8_t* data, size_t len)
     return Update(data, len, len_);
 }
 
+uint8_t* RawData::Extend(size_t len)
+{
+    if (data_ == nullptr) {
+        HILOG_ERROR(LOG_CORE, "Try to extend an invalid raw data");
+        return nullptr;
+    }
+    if ((len_ + len) > capacity_) {
+        if (!Expand(GetExpandedCapacity(capacity_, len_ + len))) {
+            return nullptr;
+        }
+    }
+    uint8_t* extended = data_ + len_;
+    len_ += len;
+    return extended;
+}
+
 bool RawData::IsEmpty()
 {
     return len_ == 0 || data_ == nullptr;
 }
 
+void RawData::Reset()
+{
+    len_ = 0;
+}
+
 bool RawData::Update(uint8_t* data, size_t len, size_t pos)
 {
     if (data == nullptr || pos > len_) {
@@ -130,26 +190,13 @@ bool RawData::Update(uint8_t* data, size_t len, size_t pos)
         HILOG_ERROR(LOG_CORE, "Try to update an invalid raw data");
         return false;
     }
-    auto ret = EOK;
     if ((pos + len) > capacity_) {
-        size_t expandedSize = (len > EXPAND_BUF_SIZE) ? len : EXPAND_BUF_SIZE;
-        size_t expandedCapacity = capacity_ + expandedSize;
-        uint8_t* resizedData = new(std::nothrow) uint8_t[expandedCapacity];
-        if (resizedData == nullptr) {
+        if (!Expand(GetExpandedCapacity(capacity_, pos + len))) {
             return false;
         }
-        ret = memcpy_s(resizedData, expandedCapacity, data_, len_);
-        if (ret != EOK) {
-            HILOG_ERROR(LOG_CORE, "Failed to expand capacity of raw data, ret is %{public}d.", ret);
-            delete[] resizedData;
-            return false;
-        }
-        capacity_ += expandedSize;
-        delete[] data_;
-        data_ = resizedData;
     }
     // append new data
-    ret = memcpy_s(data_ + pos, capacity_ - pos, data, len);
+    auto ret = memcpy_s(data_ + pos, capacity_ - pos, data, len);
     if (ret != EOK) {
         HILOG_ERROR(LOG_CORE, "Failed to append new data, ret is %{public}d.", ret);
         return false;
@@ -160,6 +207,36 @@ bool RawData::Update(uint8_t* data, size_t len, size_t pos)
     return true;
 }
 
+bool RawData::Reserve(size_t capacity)
+{
+    if (capacity <= capacity_) {
+        return true;
+    }
+    return Expand(capacity);
+}
+
+bool RawData::Expand(size_t minCapacity)
+{
+    uint8_t* resizedData = new(std::nothrow) uint8_t[minCapacity];
+    if (resizedData == nullptr) {
+        return false;
+    }
+    if (data_ != nullptr && len_ > 0) {
+        auto ret = memcpy_s(resizedData, minCapacity, data_, len_);
+        if (ret != EOK) {
+            HILOG_ERROR(LOG_CORE, "Failed to expand capacity of raw data, ret is %{public}d.", ret);
+            delete[] resizedData;
+            return false;
+        }
+    }
+    if (data_ != nullptr) {
+        delete[] data_;
+    }
+    data_ = resizedData;
+    capacity_ = minCapacity;
+    return true;
+}
+
 uint8_t* RawData::GetData() const
 {
     return data_;
@@ -169,6 +246,11 @@ size_t RawData::GetDataLength() const
 {
     return len_;
 }
+
+size_t RawData::GetCapacity() const
+{
+    return capacity_;
+}
 } // namespace Encoded
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,9 +15,12 @@
 
 #include "raw_data_encoder.h"
 
+#include <atomic>
+
 #include "hilog/log.h"
 
 #include "securec.h"
+#include "stringfilter.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
@@ -28,6 +31,10 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace Encoded {
+namespace {
+std::atomic<bool> g_isPackedArrayEnabled { false };
+}
+
 uint8_t RawDataEncoder::EncodedTag(uint8_t type)
 {
     return (type << (TAG_BYTE_OFFSET + 1));
@@ -46,6 +53,26 @@ bool RawDataEncoder::StringValueEncoded(RawData& data, const std::string& val)
     return true;
 }
 
+bool RawDataEncoder::EscapedStringValueEncoded(RawData& data, const EscapedString& val)
+{
+    auto& filter = StringFilter::GetInstance();
+    size_t escapedLen = filter.GetEscapedLength(val.str, val.len);
+    if (!UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, escapedLen)) {
+        return false;
+    }
+    if (escapedLen == 0) {
+        return true;
+    }
+    // escape the value straight into the raw data with no intermediate string
+    uint8_t* dest = data.Extend(escapedLen);
+    if (dest == nullptr) {
+        HILOG_ERROR(LOG_CORE, "string value escape failed.");
+        return false;
+    }
+    (void)filter.EscapeToRaw(val.str, val.len, reinterpret_cast<char*>(dest), escapedLen);
+    return true;
+}
+
 bool RawDataEncoder::ValueTypeEncoded(RawData& data, bool isArray, ValueType type, uint8_t count)
 {
     struct ParamValueType kvType {
@@ -58,6 +85,16 @@ bool RawDataEncoder::ValueTypeEncoded(RawData& data, bool isArray, ValueType typ
     }
     return true;
 }
+
+void RawDataEncoder::SetPackedArrayEnabled(bool enabled)
+{
+    g_isPackedArrayEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool RawDataEncoder::IsPackedArrayEnabled()
+{
+    return g_isPackedArrayEnabled.load(std::memory_order_relaxed);
+}
 } // namespace Encoded
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "stringfilter.h"
 
+#include <cstdint>
 #include <iosfwd>
 #include <istream>
 #include <ostream>
@@ -24,8 +25,93 @@
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "securec.h"
+
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+constexpr size_t SIMD_BLOCK_SIZE = 16;
+constexpr uint8_t MAX_CTRL_CHAR = 0x1F; // [0x00, 0x1F] == [END, Unit Separator]
+constexpr uint8_t DEL_CHAR = 0x7F;
+constexpr uint8_t LOWER_CASE_BIT = 0x20; // 'A' | 0x20 == 'a'
+constexpr int ALL_MATCHED_MASK = 0xFFFF; // one bit for each byte of a block
+
+inline bool IsCharToEscape(uint8_t c)
+{
+    // control characters are escaped or dropped, quotation mark and backslash are escaped
+    return (c <= MAX_CTRL_CHAR) || (c == '\"') || (c == '\\') || (c == DEL_CHAR);
+}
+
+// check whether there is any char which should be escaped or dropped in a block of SIMD_BLOCK_SIZE bytes
+inline bool HasCharToEscape(const char* block)
+{
+#if defined(__SSE2__)
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i ctrlChars = _mm_cmpeq_epi8(_mm_min_epu8(chars, _mm_set1_epi8(MAX_CTRL_CHAR)), chars);
+    __m128i specialChars = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\"')),
+        _mm_cmpeq_epi8(chars, _mm_set1_epi8('\\')));
+    __m128i matched = _mm_or_si128(_mm_or_si128(ctrlChars, specialChars),
+        _mm_cmpeq_epi8(chars, _mm_set1_epi8(DEL_CHAR)));
+    return _mm_movemask_epi8(matched) != 0;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t specialChars = vorrq_u8(vceqq_u8(chars, vdupq_n_u8('\"')), vceqq_u8(chars, vdupq_n_u8('\\')));
+    uint8x16_t matched = vorrq_u8(vorrq_u8(vcltq_u8(chars, vdupq_n_u8(MAX_CTRL_CHAR + 1)), specialChars),
+        vceqq_u8(chars, vdupq_n_u8(DEL_CHAR)));
+    // narrow each byte of the mask to 4 bits to test the whole block in a general register
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matched), 4)), 0) != 0;
+#else
+    for (size_t i = 0; i < SIMD_BLOCK_SIZE; ++i) {
+        if (IsCharToEscape(static_cast<uint8_t>(block[i]))) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+// check whether all chars in a block of SIMD_BLOCK_SIZE bytes are letters, digits or underlines
+inline bool IsNameCharBlock(const char* block)
+{
+#if defined(__SSE2__)
+    __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    // chars no less than 0x80 are negative, which are out of all ranges below
+    __m128i lowerChars = _mm_or_si128(chars, _mm_set1_epi8(LOWER_CASE_BIT));
+    __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(lowerChars, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(lowerChars, _mm_set1_epi8('z' + 1)));
+    __m128i digits = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    __m128i matched = _mm_or_si128(_mm_or_si128(letters, digits), _mm_cmpeq_epi8(chars, _mm_set1_epi8('_')));
+    return _mm_movemask_epi8(matched) == ALL_MATCHED_MASK;
+#else
+    uint8x16_t chars = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t lowerChars = vorrq_u8(chars, vdupq_n_u8(LOWER_CASE_BIT));
+    uint8x16_t letters = vandq_u8(vcgeq_u8(lowerChars, vdupq_n_u8('a')), vcleq_u8(lowerChars, vdupq_n_u8('z')));
+    uint8x16_t digits = vandq_u8(vcgeq_u8(chars, vdupq_n_u8('0')), vcleq_u8(chars, vdupq_n_u8('9')));
+    uint8x16_t matched = vorrq_u8(vorrq_u8(letters, digits), vceqq_u8(chars, vdupq_n_u8('_')));
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matched), 4)), 0) == UINT64_MAX;
+#endif
+}
+#endif
+
+// count of bytes from pos to the end of the blocks which have no char to escape
+inline size_t GetCleanBlocksLength(const char* text, size_t len, size_t pos)
+{
+    size_t end = pos;
+    while ((end + SIMD_BLOCK_SIZE <= len) && !HasCharToEscape(text + end)) {
+        end += SIMD_BLOCK_SIZE;
+    }
+    return end - pos;
+}
+}
+
 char StringFilter::charTab_[StringFilter::CHAR_RANGE][StringFilter::MAP_STR_LEN];
 int StringFilter::statTab_[StringFilter::STATE_NUM][StringFilter::CHAR_RANGE];
 StringFilter StringFilter::filter_;
@@ -78,21 +164,65 @@ StringFilter::StringFilter()
 
 std::string StringFilter::EscapeToRaw(const std::string &text)
 {
-    std::string rawText = "";
-    for (auto c : text) {
-        int ic = static_cast<int>(c);
-        if (ic >= 0 && ic < CHAR_RANGE && charTab_[ic][1]) {
-            rawText.append(charTab_[ic]);
-            continue;
+    std::string rawText(GetEscapedLength(text.c_str(), text.length()), '\0');
+    (void)EscapeToRaw(text.c_str(), text.length(), rawText.data(), rawText.length());
+    return rawText;
+}
+
+size_t StringFilter::GetEscapedCharLength(unsigned char c)
+{
+    if (!IsCharToEscape(c)) {
+        return 1;
+    }
+    // control character which is not supported with JSON is dropped
+    return (c < CHAR_RANGE && charTab_[c][1]) ? (MAP_STR_LEN - 1) : 0;
+}
+
+size_t StringFilter::GetEscapedLength(const char* text, size_t len)
+{
+    size_t escapedLen = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        size_t cleanLen = GetCleanBlocksLength(text, len, pos);
+        escapedLen += cleanLen;
+        pos += cleanLen;
+        // check the block with chars to escape or the tail of text one by one
+        for (size_t blockEnd = (pos + SIMD_BLOCK_SIZE < len) ? (pos + SIMD_BLOCK_SIZE) : len; pos < blockEnd; ++pos) {
+            escapedLen += GetEscapedCharLength(static_cast<unsigned char>(text[pos]));
         }
-        if ((ic == 0x7F) || (ic >= 0x00 && ic <= 0x1F)) {
-            // ignore control character which is not supported with JSON
-            // 0x7F == DEL, [0x00, 0x1F] == [END, Unit Separator]
-            continue;
+    }
+    return escapedLen;
+}
+
+size_t StringFilter::EscapeToRaw(const char* text, size_t len, char* dest, size_t destLen)
+{
+    size_t wroteLen = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        // copy the blocks which have no char to escape in bulk
+        size_t cleanLen = GetCleanBlocksLength(text, len, pos);
+        if (cleanLen > 0) {
+            if (memcpy_s(dest + wroteLen, destLen - wroteLen, text + pos, cleanLen) != EOK) {
+                return wroteLen;
+            }
+            wroteLen += cleanLen;
+            pos += cleanLen;
+        }
+        for (size_t blockEnd = (pos + SIMD_BLOCK_SIZE < len) ? (pos + SIMD_BLOCK_SIZE) : len; pos < blockEnd; ++pos) {
+            auto c = static_cast<unsigned char>(text[pos]);
+            size_t charLen = GetEscapedCharLength(c);
+            if (destLen - wroteLen < charLen) {
+                return wroteLen;
+            }
+            if (charLen == 1) {
+                dest[wroteLen++] = static_cast<char>(c);
+            } else if (charLen > 1) {
+                dest[wroteLen++] = charTab_[c][0];
+                dest[wroteLen++] = charTab_[c][1];
+            }
         }
-        rawText.push_back(c);
     }
-    return rawText;
+    return wroteLen;
 }
 
 bool StringFilter::IsValidName(const std::string &text, unsigned int maxSize)
@@ -103,6 +233,35 @@ bool StringFilter::IsValidName(const std::string &text, unsigned int maxSize)
     if (text.length() > maxSize) {
         return false;
     }
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+    unsigned int first = static_cast<unsigned char>(text[0]);
+    if ((first >= CHAR_RANGE) || (statTab_[STATE_BEGIN][first] == STATE_STOP)) {
+        return false;
+    }
+    // the chars after the first one are checked by blocks, and the last block overlaps with the checked ones
+    const char* chars = text.c_str() + 1;
+    size_t len = text.length() - 1;
+    size_t pos = 0;
+    for (; pos + SIMD_BLOCK_SIZE <= len; pos += SIMD_BLOCK_SIZE) {
+        if (!IsNameCharBlock(chars + pos)) {
+            return false;
+        }
+    }
+    if (pos == len) {
+        return true;
+    }
+    if (len >= SIMD_BLOCK_SIZE) {
+        return IsNameCharBlock(chars + len - SIMD_BLOCK_SIZE);
+    }
+    // the short name is cheaper to be checked one by one than to be copied into a padded block
+    for (; pos < len; ++pos) {
+        unsigned int ic = static_cast<unsigned char>(chars[pos]);
+        if ((ic >= CHAR_RANGE) || (statTab_[STATE_RUN][ic] == STATE_STOP)) {
+            return false;
+        }
+    }
+    return true;
+#else
     int state = STATE_BEGIN;
     for (auto c : text) {
         unsigned int ic = static_cast<unsigned int>(c);
@@ -115,6 +274,7 @@ bool StringFilter::IsValidName(const std::string &text, unsigned int maxSize)
         }
     }
     return true;
+#endif
 }
 
 StringFilter& StringFilter::GetInstance()
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,20 +15,35 @@
 
 #include "transport.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <pthread.h>
 #include <securec.h>
+#include <semaphore.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <string>
+#include <thread>
+#include <time.h>
 #include <unistd.h>
+#include <vector>
 
+#include "circuit_breaker.h"
 #include "def.h"
+#include "event_queue.h"
 #include "event_socket_factory.h"
+#include "event_spool.h"
 #include "hilog/log.h"
+#include "hisysevent.h"
+#include "raw_data_base_def.h"
 
 #undef LOG_DOMAIN
 #define LOG_DOMAIN 0xD002D08
@@ -39,6 +54,20 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
+constexpr int INVALID_SOCKET_ID = -1;
+constexpr size_t MAX_SERVER_CNT = 2; // hisysevent and hisysevent_fast
+constexpr size_t MAX_BATCH_EVENT_SIZE = 8 * 1024; // 8K
+constexpr char RETRY_THREAD_NAME[] = "hisysevent_retry";
+constexpr uint64_t NO_FLUSH_DELAY = UINT64_MAX;
+constexpr uint64_t MS_PER_SECOND = 1000;
+constexpr long NS_PER_MS = 1000000;
+constexpr long NS_PER_SECOND = 1000000000;
+
+std::atomic<uint32_t> g_forkGeneration { 0 };
+std::atomic<bool> g_isBatchEnabled { false };
+std::atomic<uint32_t> g_batchSize { DEFAULT_BATCH_SIZE };
+std::atomic<uint32_t> g_batchLatencyBudget { DEFAULT_BATCH_LATENCY_BUDGET };
+
 void LogErrorInfo(const std::string& logFormatStr, bool isDebugLevel)
 {
     const size_t buffSize { 256 };
@@ -50,16 +79,8 @@ void LogErrorInfo(const std::string& logFormatStr, bool isDebugLevel)
     }
     HILOG_ERROR(LOG_CORE, "%{public}s, errno=%{public}d, msg=%{public}s", logFormatStr.c_str(), errno, errMsg);
 }
-}
-
-Transport Transport::instance_;
 
-Transport& Transport::GetInstance()
-{
-    return instance_;
-}
-
-void Transport::InitRecvBuffer(int socketId)
+void InitSendBuffer(int socketId)
 {
     int oldN = 0;
     socklen_t oldOutSize = static_cast<socklen_t>(sizeof(int));
@@ -79,59 +100,762 @@ void Transport::InitRecvBuffer(int socketId)
     }
 }
 
-int Transport::SendToHiSysEventDataSource(RawData& rawData)
+void OnChildForked()
+{
+    // sockets inherited from the parent process must not be shared with it
+    g_forkGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+void InitForkHandler()
+{
+    static const int atForkRet = pthread_atfork(nullptr, nullptr, OnChildForked);
+    (void)atForkRet;
+}
+
+inline bool IsServerReset(int err)
+{
+    return err == ECONNREFUSED || err == ENOENT || err == ENOTCONN;
+}
+
+inline uint64_t GetMonotonicTimeMills()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool IsFaultEvent(const RawData& rawData)
+{
+    if (rawData.GetDataLength() < sizeof(int32_t) + sizeof(struct HiSysEventHeader)) {
+        return false;
+    }
+    auto header = reinterpret_cast<struct HiSysEventHeader*>(rawData.GetData() + sizeof(int32_t));
+    return header->type == static_cast<uint8_t>(HiSysEvent::EventType::FAULT - 1); // header stores type - 1
+}
+
+class ClientSocket {
+public:
+    ClientSocket() = default;
+    ~ClientSocket()
+    {
+        Close();
+    }
+    ClientSocket(const ClientSocket&) = delete;
+    ClientSocket& operator=(const ClientSocket&) = delete;
+
+public:
+    bool IsBoundTo(const EventSocket& serverAddr) const
+    {
+        return serverAddr_ == &serverAddr;
+    }
+
+    bool IsIdle() const
+    {
+        return serverAddr_ == nullptr;
+    }
+
+    void Bind(const EventSocket& serverAddr)
+    {
+        Close();
+        serverAddr_ = &serverAddr;
+    }
+
+    void CheckFork()
+    {
+        auto forkGeneration = g_forkGeneration.load(std::memory_order_relaxed);
+        if (forkGeneration != forkGeneration_) {
+            Close();
+            forkGeneration_ = forkGeneration;
+        }
+    }
+
+    void Unbind()
+    {
+        Close();
+        serverAddr_ = nullptr;
+    }
+
+    int Connect()
+    {
+        if (socketId_ >= 0) {
+            return SUCCESS;
+        }
+        auto socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+        if (socketId < 0) {
+            LogErrorInfo("create hisysevent client socket failed", true);
+            return ERR_DOES_NOT_INIT;
+        }
+        InitSendBuffer(socketId);
+        if (TEMP_FAILURE_RETRY(connect(socketId, reinterpret_cast<const sockaddr*>(serverAddr_),
+            sizeof(*serverAddr_))) < 0) {
+            std::string errDes(serverAddr_->sun_path);
+            errDes.append(" connect failed");
+            LogErrorInfo(errDes, errno == EACCES);
+            close(socketId);
+            return ERR_SEND_FAIL;
+        }
+        socketId_ = socketId;
+        return SUCCESS;
+    }
+
+    ssize_t Send(RawData& rawData)
+    {
+        ssize_t sendRet = 0;
+        auto retryTimes = RETRY_TIMES;
+        do {
+            sendRet = send(socketId_, rawData.GetData(), rawData.GetDataLength(), 0);
+            retryTimes--;
+        } while (sendRet < 0 && retryTimes > 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+        return sendRet;
+    }
+
+    int SendBatch(struct mmsghdr* msgs, unsigned int cnt)
+    {
+        int sendRet = 0;
+        auto retryTimes = RETRY_TIMES;
+        do {
+            sendRet = sendmmsg(socketId_, msgs, cnt, 0);
+            retryTimes--;
+        } while (sendRet < 0 && retryTimes > 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
+        return sendRet;
+    }
+
+    void Close()
+    {
+        if (socketId_ >= 0) {
+            close(socketId_);
+            socketId_ = INVALID_SOCKET_ID;
+        }
+    }
+
+    const char* GetServerPath() const
+    {
+        return serverAddr_->sun_path;
+    }
+
+private:
+    static constexpr int RETRY_TIMES = 3;
+    const EventSocket* serverAddr_ = nullptr;
+    int socketId_ = INVALID_SOCKET_ID;
+    uint32_t forkGeneration_ = 0;
+};
+
+// each thread keeps its own sockets connected, so no lock is needed to send events
+thread_local ClientSocket g_clientSockets[MAX_SERVER_CNT];
+thread_local uint32_t g_socketPathGeneration = 0;
+
+void CheckSocketPath()
+{
+    // sockets connected to the previous paths are released for the current ones
+    auto pathGeneration = EventSocketFactory::GetSocketPathGeneration();
+    if (pathGeneration == g_socketPathGeneration) {
+        return;
+    }
+    for (auto& clientSocket : g_clientSockets) {
+        clientSocket.Unbind();
+    }
+    g_socketPathGeneration = pathGeneration;
+}
+
+ClientSocket& GetClientSocket(const EventSocket& serverAddr)
+{
+    InitForkHandler();
+    CheckSocketPath();
+    ClientSocket* socket = nullptr;
+    for (auto& clientSocket : g_clientSockets) {
+        if (clientSocket.IsBoundTo(serverAddr)) {
+            socket = &clientSocket;
+            break;
+        }
+        if (socket == nullptr && clientSocket.IsIdle()) {
+            socket = &clientSocket;
+        }
+    }
+    if (socket == nullptr) {
+        socket = &g_clientSockets[MAX_SERVER_CNT - 1];
+    }
+    if (!socket->IsBoundTo(serverAddr)) {
+        socket->Bind(serverAddr);
+    }
+    socket->CheckFork();
+    return *socket;
+}
+
+class EventBatch;
+
+// batches of all threads, so that the retry thread flushes the staged events once their latency budget is used
+// up, even if the threads never write again. The list is locked while a batch is flushed in background, so that
+// the batch is never released by its exiting thread meanwhile.
+struct BatchList {
+    std::mutex mutex;
+    std::vector<EventBatch*> batches;
+};
+
+BatchList& GetBatchList()
+{
+    // never released, the retry thread may be still running while the process exits
+    static BatchList* batchList = new BatchList();
+    return *batchList;
+}
+
+void LockBatchList()
+{
+    GetBatchList().mutex.lock();
+}
+
+void UnlockBatchList()
+{
+    GetBatchList().mutex.unlock();
+}
+
+void ResetBatchListInChild()
+{
+    // only the forking thread survives, whose batch is added again once it stages events
+    auto& batchList = GetBatchList();
+    batchList.batches.clear();
+    batchList.mutex.unlock();
+}
+
+void InitBatchListForkHandler()
+{
+    // the list is never locked across fork, so that it is still usable in the child process
+    static const int atForkRet = pthread_atfork(LockBatchList, UnlockBatchList, ResetBatchListInChild);
+    (void)atForkRet;
+}
+
+void AddToBatchList(EventBatch* batch)
+{
+    auto& batchList = GetBatchList();
+    std::lock_guard<std::mutex> lock(batchList.mutex);
+    batchList.batches.push_back(batch);
+}
+
+void RemoveFromBatchList(EventBatch* batch)
+{
+    auto& batchList = GetBatchList();
+    std::lock_guard<std::mutex> lock(batchList.mutex);
+    auto& batches = batchList.batches;
+    batches.erase(std::remove(batches.begin(), batches.end(), batch), batches.end());
+}
+
+bool IsBatchable(RawData& rawData, const EventRoute& route)
+{
+    // bigger events are sent directly to bound the memory kept by each thread, and events need to be
+    // handled urgently should never be delayed
+    return rawData.GetDataLength() <= MAX_BATCH_EVENT_SIZE && !route.isUrgent;
+}
+
+class EventBatch {
+public:
+    EventBatch()
+    {
+        InitForkHandler();
+        InitBatchListForkHandler();
+        forkGeneration_ = g_forkGeneration.load(std::memory_order_relaxed);
+        AddToBatchList(this);
+    }
+    ~EventBatch()
+    {
+        RemoveFromBatchList(this);
+        // the exiting thread has no chance to retry, so events failed to send are dropped
+        if (Flush([] (RawData&) {}) != SUCCESS) {
+            HILOG_WARN(LOG_CORE, "drop events staged by the exiting thread");
+        }
+    }
+    EventBatch(const EventBatch&) = delete;
+    EventBatch& operator=(const EventBatch&) = delete;
+
+public:
+    bool IsEmpty() const
+    {
+        return eventCnt_.load(std::memory_order_relaxed) == 0;
+    }
+
+    bool IsReadyToFlush(uint64_t now) const
+    {
+        auto batchSize = std::clamp(g_batchSize.load(std::memory_order_relaxed), 1U, MAX_BATCH_SIZE);
+        return eventCnt_.load(std::memory_order_relaxed) >= batchSize ||
+            IsExpired(now, g_batchLatencyBudget.load(std::memory_order_relaxed));
+    }
+
+    // milliseconds to the latency budget of the staged events to be used up
+    bool GetFlushDelay(uint64_t now, uint64_t budget, uint64_t& delay) const
+    {
+        if (IsEmpty()) {
+            return false;
+        }
+        auto deadline = firstStagedTime_.load(std::memory_order_relaxed) + budget;
+        delay = (deadline > now) ? (deadline - now) : 0;
+        return true;
+    }
+
+    bool Stage(RawData& rawData, const EventSocket& serverAddr, uint64_t now)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CheckFork();
+        auto eventCnt = eventCnt_.load(std::memory_order_relaxed);
+        if (eventCnt >= MAX_BATCH_SIZE) {
+            return false;
+        }
+        if (!socket_.IsBoundTo(serverAddr)) {
+            if (eventCnt != 0) {
+                return false;
+            }
+            socket_.Bind(serverAddr);
+        }
+        auto& event = events_[eventCnt];
+        event.Reset();
+        if (!event.Append(rawData.GetData(), rawData.GetDataLength())) {
+            return false;
+        }
+        if (eventCnt == 0) {
+            firstStagedTime_.store(now, std::memory_order_relaxed);
+        }
+        eventCnt_.store(eventCnt + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template<typename F>
+    int Flush(F onSendFailed)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CheckFork();
+        return FlushLocked(onSendFailed);
+    }
+
+    // called by the retry thread, the batch being used by its own thread is left to it
+    template<typename F>
+    bool FlushIfExpired(uint64_t now, uint64_t budget, F onSendFailed, int& ret)
+    {
+        if (!IsExpired(now, budget)) {
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock() || IsEmpty()) {
+            return false;
+        }
+        ret = FlushLocked(onSendFailed);
+        return true;
+    }
+
+private:
+    bool IsExpired(uint64_t now, uint64_t budget) const
+    {
+        return !IsEmpty() && now - firstStagedTime_.load(std::memory_order_relaxed) >= budget;
+    }
+
+    // should be called with mutex_ locked
+    void CheckFork()
+    {
+        // events staged before fork will be sent by the parent process
+        auto forkGeneration = g_forkGeneration.load(std::memory_order_relaxed);
+        if (forkGeneration != forkGeneration_) {
+            eventCnt_.store(0, std::memory_order_relaxed);
+            socket_.CheckFork();
+            forkGeneration_ = forkGeneration;
+            AddToBatchList(this);
+        }
+    }
+
+    // should be called with mutex_ locked
+    template<typename F>
+    int FlushLocked(F onSendFailed)
+    {
+        auto eventCnt = eventCnt_.load(std::memory_order_relaxed);
+        if (eventCnt == 0) {
+            return SUCCESS;
+        }
+        unsigned int sentCnt = 0;
+        int ret = Send(eventCnt, sentCnt);
+        for (auto i = sentCnt; i < eventCnt; i++) {
+            onSendFailed(events_[i]);
+        }
+        eventCnt_.store(0, std::memory_order_relaxed);
+        return ret;
+    }
+
+    int Send(unsigned int eventCnt, unsigned int& sentCnt)
+    {
+        if (auto ret = socket_.Connect(); ret != SUCCESS) {
+            return ret;
+        }
+        // each event is still sent as a single datagram, so the receiver does not need to change
+        for (unsigned int i = 0; i < eventCnt; i++) {
+            iovs_[i].iov_base = events_[i].GetData();
+            iovs_[i].iov_len = events_[i].GetDataLength();
+            msgs_[i] = {};
+            msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+            msgs_[i].msg_hdr.msg_iovlen = 1;
+        }
+        bool isReconnected = false;
+        while (sentCnt < eventCnt) {
+            auto sendRet = socket_.SendBatch(&msgs_[sentCnt], eventCnt - sentCnt);
+            if (sendRet > 0) {
+                sentCnt += static_cast<unsigned int>(sendRet);
+                continue;
+            }
+            if (sendRet < 0 && IsServerReset(errno) && !isReconnected) {
+                // the server socket has been recreated, reconnect to the new one and send again
+                isReconnected = true;
+                socket_.Close();
+                if (auto ret = socket_.Connect(); ret != SUCCESS) {
+                    return ret;
+                }
+                continue;
+            }
+            std::string errDes(socket_.GetServerPath());
+            errDes.append(" batch write failed");
+            LogErrorInfo(errDes, errno == EACCES);
+            return ERR_SEND_FAIL;
+        }
+        return SUCCESS;
+    }
+
+private:
+    // the staged events are only sent by the retry thread besides the owner thread
+    std::mutex mutex_;
+    ClientSocket socket_;
+    RawData events_[MAX_BATCH_SIZE];
+    struct iovec iovs_[MAX_BATCH_SIZE] = {};
+    struct mmsghdr msgs_[MAX_BATCH_SIZE] = {};
+    std::atomic<unsigned int> eventCnt_ { 0 };
+    std::atomic<uint64_t> firstStagedTime_ { 0 };
+    uint32_t forkGeneration_ = 0;
+};
+
+// milliseconds to the latency budget of any staged events to be used up, NO_FLUSH_DELAY if nothing is staged
+uint64_t GetBatchFlushDelay()
+{
+    auto now = GetMonotonicTimeMills();
+    uint64_t budget = g_batchLatencyBudget.load(std::memory_order_relaxed);
+    uint64_t minDelay = NO_FLUSH_DELAY;
+    auto& batchList = GetBatchList();
+    std::lock_guard<std::mutex> lock(batchList.mutex);
+    for (auto batch : batchList.batches) {
+        uint64_t delay = 0;
+        if (batch->GetFlushDelay(now, budget, delay)) {
+            minDelay = std::min(minDelay, delay);
+        }
+    }
+    return minDelay;
+}
+
+void ReportBatchFlushed(int ret)
 {
-    // reopen the socket with an new id each time is neccessary here, which is more efficient than that
-    // reuse id of the opened socket and then use a mutex to avoid multi-threading race.
-    auto socketId = TEMP_FAILURE_RETRY(socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
-    if (socketId < 0) {
-        LogErrorInfo("create hisysevent client socket failed", true);
-        return ERR_DOES_NOT_INIT;
+    if (ret == SUCCESS) {
+        CircuitBreaker::GetInstance().OnSendSucceeded();
+    } else {
+        CircuitBreaker::GetInstance().OnSendFailed();
+    }
+}
+
+void WaitForProbe(uint64_t delay)
+{
+    // wait at least 1ms, since the probe may be sent by a writing thread meanwhile
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::max<uint64_t>(delay, 1)));
+}
+
+EventQueue& GetRetryQueue()
+{
+    // never released, the retry thread may be still running while the process exits
+    static EventQueue* retryQueue = new EventQueue(Transport::RETRY_QUEUE_SIZE);
+    return *retryQueue;
+}
+
+// events staged by each thread, which are sent together by one sendmmsg call, the batch will
+// only be created by the thread writes events in batch mode
+thread_local std::unique_ptr<EventBatch> g_eventBatch = nullptr;
+}
+
+Transport Transport::instance_;
+
+Transport::Transport()
+{
+    (void)sem_init(&wakeUpSem_, 0, 0);
+}
+
+Transport& Transport::GetInstance()
+{
+    return instance_;
+}
+
+int Transport::SendToHiSysEventDataSource(RawData& rawData, const EventSocket& serverAddr)
+{
+    auto& clientSocket = GetClientSocket(serverAddr);
+    if (auto ret = clientSocket.Connect(); ret != SUCCESS) {
+        return ret;
+    }
+    auto sendRet = clientSocket.Send(rawData);
+    if (sendRet < 0 && IsServerReset(errno)) {
+        // the server socket has been recreated, reconnect to the new one and send again
+        clientSocket.Close();
+        if (auto ret = clientSocket.Connect(); ret != SUCCESS) {
+            return ret;
+        }
+        sendRet = clientSocket.Send(rawData);
     }
-    InitRecvBuffer(socketId);
-    auto sendRet = 0;
-    auto retryTimes = RETRY_TIMES;
-    std::string errDes;
-    do {
-        auto serverAddr = EventSocketFactory::GetEventSocket(rawData);
-        errDes = serverAddr.sun_path;
-        sendRet = sendto(socketId, rawData.GetData(), rawData.GetDataLength(), 0,
-            reinterpret_cast<sockaddr*>(&serverAddr), sizeof(serverAddr));
-        retryTimes--;
-    } while (sendRet < 0 && retryTimes > 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR));
     if (sendRet < 0) {
+        std::string errDes(clientSocket.GetServerPath());
         errDes.append(" write failed");
         LogErrorInfo(errDes, errno == EACCES);
-        close(socketId);
         return ERR_SEND_FAIL;
     }
-    close(socketId);
     HILOG_DEBUG(LOG_CORE, "hisysevent send data successful");
     return SUCCESS;
 }
 
+int Transport::StageData(RawData& rawData, const EventSocket& serverAddr)
+{
+    if (g_eventBatch == nullptr) {
+        g_eventBatch = std::make_unique<EventBatch>();
+    }
+    auto now = GetMonotonicTimeMills();
+    bool isFirstStaged = g_eventBatch->IsEmpty();
+    if (!g_eventBatch->Stage(rawData, serverAddr, now)) {
+        if (auto ret = FlushBatch(); ret != SUCCESS) {
+            AddFailedData(rawData);
+            return ret;
+        }
+        isFirstStaged = true;
+        if (!g_eventBatch->Stage(rawData, serverAddr, now)) {
+            return ERR_RAW_DATA_WROTE_EXCEPTION;
+        }
+    }
+    if (g_eventBatch->IsReadyToFlush(now)) {
+        return FlushBatch();
+    }
+    // the retry thread waits for the latency budget of the events to be used up, and flushes them unless the
+    // thread writes next event in time
+    if (isFirstStaged && StartRetrier()) {
+        WakeUpRetrier();
+    }
+    return SUCCESS;
+}
+
+int Transport::FlushBatch()
+{
+    if (g_eventBatch == nullptr || g_eventBatch->IsEmpty()) {
+        return SUCCESS;
+    }
+    int ret = g_eventBatch->Flush([this] (RawData& rawData) {
+        AddFailedData(rawData);
+    });
+    ReportBatchFlushed(ret);
+    return ret;
+}
+
+void Transport::FlushExpiredBatches()
+{
+    auto now = GetMonotonicTimeMills();
+    uint64_t budget = g_batchLatencyBudget.load(std::memory_order_relaxed);
+    auto& batchList = GetBatchList();
+    std::lock_guard<std::mutex> lock(batchList.mutex);
+    for (auto batch : batchList.batches) {
+        int ret = SUCCESS;
+        if (batch->FlushIfExpired(now, budget, [this] (RawData& rawData) { AddFailedData(rawData); }, ret)) {
+            ReportBatchFlushed(ret);
+        }
+    }
+}
+
+void Transport::SetBatchMode(bool enabled, uint32_t batchSize, uint32_t latencyBudget)
+{
+    g_batchSize.store(std::clamp(batchSize, 1U, MAX_BATCH_SIZE), std::memory_order_relaxed);
+    g_batchLatencyBudget.store(latencyBudget, std::memory_order_relaxed);
+    g_isBatchEnabled.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        (void)FlushBatch();
+    }
+}
+
+int Transport::Flush()
+{
+    return FlushBatch();
+}
+
+bool Transport::SetSpool(bool enabled, const std::string& path, uint32_t capacity)
+{
+    auto& spool = EventSpool::GetInstance();
+    if (!enabled) {
+        // events left in the spool file are sent once it is opened again, eg. by the next process
+        spool.Close();
+        return true;
+    }
+    if (!spool.Open(path, capacity)) {
+        return false;
+    }
+    if (!spool.IsEmpty()) {
+        // events left by the former process are sent in background
+        hasFailedData_.store(true);
+        if (StartRetrier()) {
+            WakeUpRetrier();
+        }
+    }
+    return true;
+}
+
 void Transport::AddFailedData(RawData& rawData)
 {
+    // fault events are kept by the spool if it is opened and not full, which never drops the oldest ones
+    if (!IsFaultEvent(rawData) || !EventSpool::GetInstance().Append(rawData)) {
+        // the oldest failed data will be dropped if the queue is full
+        EventQueue::PushResult ret;
+        while ((ret = GetRetryQueue().Push(rawData)) == EventQueue::PushResult::FULL) {
+            (void)GetRetryQueue().Pop([] (RawData&) {});
+        }
+        if (ret == EventQueue::PushResult::COPY_FAILED) {
+            HILOG_WARN(LOG_CORE, "failed to copy the event to retry, len=%{public}zu", rawData.GetDataLength());
+            return;
+        }
+    }
+    hasFailedData_.store(true);
+    // the retry thread is not woken up while the breaker is open, it is waiting for the next probe
+    if (StartRetrier() && CircuitBreaker::GetInstance().IsClosed()) {
+        WakeUpRetrier();
+    }
+}
+
+bool Transport::StartRetrier()
+{
+    if (isRetrierStarted_.load(std::memory_order_acquire)) {
+        return true;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    if (retryDataList_.size() >= RETRY_QUEUE_SIZE) {
-        retryDataList_.pop_front();
+    if (isRetrierStarted_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    static const int atForkRet = pthread_atfork(nullptr, nullptr, ResetRetrierAfterFork);
+    (void)atForkRet;
+    pthread_t tid;
+    if (pthread_create(&tid, nullptr, RetryInBackground, this) != 0) {
+        HILOG_ERROR(LOG_CORE, "failed to create thread to retry sending, errno=%{public}d", errno);
+        return false;
     }
-    retryDataList_.push_back(rawData);
+    (void)pthread_detach(tid);
+    isRetrierStarted_.store(true, std::memory_order_release);
+    return true;
+}
+
+void Transport::WakeUpRetrier()
+{
+    if (isRetrierSleeping_.exchange(false)) {
+        (void)sem_post(&wakeUpSem_);
+    }
+}
+
+void Transport::WaitForRetry(bool isTimed)
+{
+    isRetrierSleeping_.store(true);
+    // events in the spool are retried periodically instead of waiting for the next event, which may never come
+    if (GetRetryQueue().IsEmpty() && (isTimed || EventSpool::GetInstance().IsEmpty())) {
+        // staged events are flushed once their latency budget is used up
+        uint64_t timeout = std::min(isTimed ? RETRY_INTERVAL * MS_PER_SECOND : NO_FLUSH_DELAY,
+            GetBatchFlushDelay());
+        if (timeout != NO_FLUSH_DELAY) {
+            struct timespec ts = { 0, 0 };
+            (void)clock_gettime(CLOCK_REALTIME, &ts);
+            timeout = std::max<uint64_t>(timeout, 1); // wait 1ms at least, the expired batch may be in use
+            ts.tv_sec += static_cast<time_t>(timeout / MS_PER_SECOND);
+            ts.tv_nsec += static_cast<long>(timeout % MS_PER_SECOND) * NS_PER_MS;
+            if (ts.tv_nsec >= NS_PER_SECOND) {
+                ts.tv_sec++;
+                ts.tv_nsec -= NS_PER_SECOND;
+            }
+            while (sem_timedwait(&wakeUpSem_, &ts) != 0 && errno == EINTR) {}
+        } else {
+            while (sem_wait(&wakeUpSem_) != 0 && errno == EINTR) {}
+        }
+    }
+    isRetrierSleeping_.store(false);
 }
 
 void Transport::RetrySendFailedData()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    while (!retryDataList_.empty()) {
-        auto rawData = retryDataList_.front();
-        if (SendToHiSysEventDataSource(rawData) != SUCCESS) {
+    // only accessed by the retry thread, so that the writing threads never wait for retrying
+    std::list<RawData> failedDataList;
+    RawData spooledData;
+    auto& breaker = CircuitBreaker::GetInstance();
+    auto& spool = EventSpool::GetInstance();
+    int retryRounds = 0;
+    while (true) {
+        FlushExpiredBatches();
+        while (GetRetryQueue().Pop([&failedDataList] (RawData& rawData) {
+            if (failedDataList.size() >= RETRY_QUEUE_SIZE) {
+                failedDataList.pop_front();
+            }
+            failedDataList.push_back(rawData);
+        })) {}
+        while (!failedDataList.empty() && breaker.IsSendAllowed()) {
+            auto& rawData = failedDataList.front();
+            if (SendToHiSysEventDataSource(rawData, EventSocketFactory::GetEventSocket(rawData)) != SUCCESS) {
+                breaker.OnSendFailed();
+                break;
+            }
+            breaker.OnSendSucceeded();
+            failedDataList.pop_front();
+        }
+        if (failedDataList.empty()) {
+            RetrySendSpooledData(spooledData);
+        }
+        if (failedDataList.empty() && spool.IsEmpty()) {
+            hasFailedData_.store(false);
+            if (!GetRetryQueue().IsEmpty() || !spool.IsEmpty()) {
+                hasFailedData_.store(true);
+                continue;
+            }
+            retryRounds = 0;
+            WaitForRetry(false);
+        } else if (!breaker.IsClosed()) {
+            // the writing threads fail fast and never wake up the retry thread, which probes hiview by itself
+            WaitForProbe(breaker.GetProbeDelay());
+        } else if (++retryRounds < MAX_RETRY_ROUNDS) {
+            WaitForRetry(true);
+        } else {
+            // hiview keeps unavailable, wait for the next event written successfully or failed
+            retryRounds = 0;
+            WaitForRetry(false);
+        }
+    }
+}
+
+void Transport::RetrySendSpooledData(RawData& rawData)
+{
+    // the event is removed from the spool only after it is sent, so that it survives the exit of the process
+    auto& spool = EventSpool::GetInstance();
+    auto& breaker = CircuitBreaker::GetInstance();
+    while (spool.Front(rawData) && breaker.IsSendAllowed()) {
+        if (SendToHiSysEventDataSource(rawData, EventSocketFactory::GetEventSocket(rawData)) != SUCCESS) {
+            breaker.OnSendFailed();
             return;
         }
-        retryDataList_.pop_front();
+        breaker.OnSendSucceeded();
+        spool.Pop();
     }
 }
 
+void* Transport::RetryInBackground(void* arg)
+{
+    (void)pthread_setname_np(pthread_self(), RETRY_THREAD_NAME);
+    static_cast<Transport*>(arg)->RetrySendFailedData();
+    return nullptr;
+}
+
+void Transport::ResetRetrierAfterFork()
+{
+    // the retry thread does not exist in the child process, and the failed data will be sent by the parent
+    auto& transport = GetInstance();
+    GetRetryQueue().Reset();
+    (void)sem_init(&transport.wakeUpSem_, 0, 0);
+    transport.hasFailedData_.store(false, std::memory_order_relaxed);
+    transport.isRetrierSleeping_.store(false, std::memory_order_relaxed);
+    transport.isRetrierStarted_.store(false, std::memory_order_relaxed);
+}
+
 int Transport::SendData(RawData& rawData)
+{
+    return SendData(rawData, EventSocketFactory::GetEventRoute(rawData));
+}
+
+int Transport::SendData(RawData& rawData, const EventRoute& route)
 {
     if (rawData.IsEmpty()) {
         HILOG_WARN(LOG_CORE, "try to send a empty data.");
@@ -142,16 +866,38 @@ int Transport::SendData(RawData& rawData)
         return ERR_OVER_SIZE;
     }
 
-    RetrySendFailedData();
+    if (g_isBatchEnabled.load(std::memory_order_relaxed)) {
+        if (IsBatchable(rawData, route)) {
+            return StageData(rawData, *route.socket);
+        }
+    } else if (g_eventBatch != nullptr && !g_eventBatch->IsEmpty()) {
+        // send events staged before the batch mode is disabled first
+        (void)FlushBatch();
+    }
+    // the event probing hiview is only sent once, since the breaker is not closed until it succeeds
+    auto& breaker = CircuitBreaker::GetInstance();
     int tryTimes = RETRY_TIMES;
-    int retCode = SUCCESS;
-    while (tryTimes > 0) {
+    int retCode = ERR_SEND_FAIL;
+    bool isAttempted = false;
+    while (tryTimes > 0 && breaker.IsSendAllowed()) {
         tryTimes--;
-        retCode = SendToHiSysEventDataSource(rawData);
+        isAttempted = true;
+        retCode = SendToHiSysEventDataSource(rawData, *route.socket);
         if (retCode == SUCCESS) {
+            breaker.OnSendSucceeded();
+            if (hasFailedData_.load(std::memory_order_relaxed)) {
+                // hiview may be available again
+                WakeUpRetrier();
+            }
             return retCode;
         }
     }
+    if (isAttempted) {
+        breaker.OnSendFailed();
+    } else {
+        // hiview keeps unavailable, leave the event to the retry thread which probes it with backoff
+        breaker.OnFastFailed();
+    }
 
     AddFailedData(rawData);
     return retCode;
@@ -15,16 +15,18 @@
 
 #include "write_controller.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
-#include <mutex>
 #include <ostream>
 #include <sys/time.h>
 #include <sstream>
 #include <string>
+#include <time.h>
 
+#include "event_wrote_record_table.h"
 #include "hilog/log.h"
 
 #undef LOG_DOMAIN
@@ -35,7 +37,6 @@
 
 namespace OHOS {
 namespace HiviewDFX {
-constexpr size_t LRU_CACHE_DEFAULT_SIZE = 30;
 namespace {
 uint64_t GenerateHash(const std::string& info)
 {
@@ -60,78 +61,93 @@ uint64_t ConcatenateInfoAsKey(const char* eventName, const char* func, int64_t l
     return GenerateHash(key);
 }
 
-struct EventWroteRecord {
-    size_t count = 0;
-    uint64_t timestamp = INVALID_TIME_STAMP;
-};
+constexpr uint64_t COUNT_BITS = 24;
+constexpr uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+constexpr uint64_t EMPTY_KEY = 0;
+constexpr uint64_t SEC_TO_MILLS = 1000; // second to millisecond
+constexpr uint64_t NANOS_PER_MILLI = 1000000; // nanosecond to millisecond
 
-struct EventWroteCacheNode {
-    std::list<uint64_t>::const_iterator iter;
-    struct EventWroteRecord record;
-};
+// the timestamp in seconds and count of events wrote are packed together to be updated atomically
+inline uint64_t PackRecord(uint64_t timestamp, uint64_t count)
+{
+    return (timestamp << COUNT_BITS) | (count & COUNT_MASK);
 }
 
-class EventWroteLruCache {
-public:
-    explicit EventWroteLruCache(size_t capacity): capacity_(capacity) {}
+inline uint64_t GetRecordTimestamp(uint64_t record)
+{
+    return record >> COUNT_BITS;
+}
 
-    ~EventWroteLruCache()
-    {
-        key2Index_.clear();
-    }
+inline uint64_t GetRecordCount(uint64_t record)
+{
+    return record & COUNT_MASK;
+}
 
-public:
-    struct EventWroteRecord Get(uint64_t key)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        EventWroteRecord record;
-        if (key2Index_.count(key) == 0) {
-            return record;
+uint64_t CheckLimitByRecord(const ControlParam& param, const char* domain, const char* eventName,
+    const char* func, uint64_t cur, CallSiteRecord& record)
+{
+    uint64_t curSec = cur / SEC_TO_MILLS;
+    uint64_t oldRecord = record.load(std::memory_order_relaxed);
+    uint64_t newRecord = 0;
+    do {
+        uint64_t timestamp = GetRecordTimestamp(oldRecord);
+        uint64_t count = GetRecordCount(oldRecord);
+        if ((count == 0) || (timestamp + param.period < curSec) || (timestamp > curSec)) {
+            newRecord = PackRecord(curSec, 1); // record the first event writing during one cycle
+        } else {
+            newRecord = PackRecord(timestamp, (count < COUNT_MASK) ? (count + 1) : count);
         }
-        Modify(key);
-        return key2Index_[key].record;
+    } while (!record.compare_exchange_weak(oldRecord, newRecord, std::memory_order_relaxed));
+    uint64_t count = GetRecordCount(newRecord);
+    if (count <= param.threshold) {
+        return cur;
     }
+    HILOG_DEBUG(LOG_CORE, "{.period = %{public}zu, .threshold = %{public}zu} "
+        "[%{public}lld, %{public}lld] discard %{public}zu event(s) "
+        "with domain %{public}s and name %{public}s which wrote in function %{public}s.",
+        param.period, param.threshold, static_cast<long long>(GetRecordTimestamp(newRecord)),
+        static_cast<long long>(curSec), static_cast<size_t>(count - param.threshold),
+        domain, eventName, func);
+    return INVALID_TIME_STAMP;
+}
+}
 
-    void Put(uint64_t key, struct EventWroteRecord record)
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (capacity_ == 0) {
-            return;
+CallSiteRecord& EventWroteRecordTable::GetRecord(uint64_t key)
+{
+    key = (key == EMPTY_KEY) ? 1 : key; // 0 is reserved for empty slot
+    size_t index = static_cast<size_t>(key) & (TABLE_SIZE - 1);
+    Slot* oldestSlot = nullptr;
+    for (size_t i = 0; i < PROBE_LIMIT; i++) {
+        auto& slot = slots_[(index + i) & (TABLE_SIZE - 1)];
+        auto slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == EMPTY_KEY &&
+            slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel)) {
+            return slot.record;
         }
-        if (key2Index_.count(key) > 0) {
-            key2Index_[key].record = record;
-            Modify(key);
-            return;
+        if (slotKey == key) {
+            return slot.record;
         }
-        if (keyCache_.size() == capacity_) {
-            key2Index_.erase(keyCache_.back());
-            keyCache_.pop_back();
+        if (oldestSlot == nullptr || GetRecordTimestamp(slot.record.load(std::memory_order_relaxed)) <
+            GetRecordTimestamp(oldestSlot->record.load(std::memory_order_relaxed))) {
+            oldestSlot = &slot;
         }
-        keyCache_.push_front(key);
-        key2Index_[key] = {
-            .iter = keyCache_.cbegin(),
-            .record = record
-        };
-    }
-
-private:
-    void Modify(uint64_t key)
-    {
-        keyCache_.splice(keyCache_.begin(), keyCache_, key2Index_[key].iter);
-        key2Index_[key].iter = keyCache_.cbegin();
     }
+    oldestSlot->key.store(key, std::memory_order_release);
+    oldestSlot->record.store(PackRecord(0, 0), std::memory_order_relaxed);
+    return oldestSlot->record;
+}
 
-private:
-    std::mutex mutex_;
-    std::unordered_map<uint64_t, EventWroteCacheNode> key2Index_;
-    std::list<uint64_t> keyCache_;
-    size_t capacity_ = 0;
-};
-
-__attribute__((no_destroy)) EventWroteLruCache WriteController::eventWroteLruCache_(LRU_CACHE_DEFAULT_SIZE);
+__attribute__((no_destroy)) EventWroteRecordTable WriteController::eventWroteRecordTable_;
 
 uint64_t WriteController::GetCurrentTimeMills()
 {
+#ifdef HISYSEVENT_COARSE_CLOCK_ENABLED
+    // the coarse clock is read from vdso without a syscall, and its precision is one tick of kernel
+    struct timespec ts = { 0, 0 };
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+        return static_cast<uint64_t>(ts.tv_sec) * SEC_TO_MILLS + static_cast<uint64_t>(ts.tv_nsec) / NANOS_PER_MILLI;
+    }
+#endif
     auto now = std::chrono::system_clock::now();
     auto millisecs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch());
     return millisecs.count();
@@ -141,29 +157,8 @@ uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, cons
     const CallerInfo& callerInfo)
 {
     uint64_t key = ConcatenateInfoAsKey(eventName, callerInfo.func, callerInfo.line);
-    auto record = eventWroteLruCache_.Get(key);
-    uint64_t cur = callerInfo.timeStamp;
-    const uint64_t secToMillis = 1000; // second to millisecond
-    if ((record.count == 0) || ((record.timestamp / secToMillis) + param.period < (cur / secToMillis)) ||
-        ((record.timestamp / secToMillis) > (cur / secToMillis))) {
-        record.count = 1; // record the first event writing during one cycle
-        record.timestamp = cur;
-        eventWroteLruCache_.Put(key, record);
-        return cur;
-    }
-    record.count++;
-    if (record.count <= param.threshold) {
-        eventWroteLruCache_.Put(key, record);
-        return cur;
-    }
-    eventWroteLruCache_.Put(key, record);
-    HILOG_DEBUG(LOG_CORE, "{.period = %{public}zu, .threshold = %{public}zu} "
-        "[%{public}lld, %{public}lld] discard %{public}zu event(s) "
-        "with domain %{public}s and name %{public}s which wrote in function %{public}s.",
-        param.period, param.threshold, static_cast<long long>(record.timestamp / secToMillis),
-        static_cast<long long>(cur / secToMillis), record.count - param.threshold,
-        domain, eventName, callerInfo.func);
-    return INVALID_TIME_STAMP;
+    return CheckLimitByRecord(param, domain, eventName, callerInfo.func, callerInfo.timeStamp,
+        eventWroteRecordTable_.GetRecord(key));
 }
 
 uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, const char* domain,
@@ -176,5 +171,11 @@ uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, cons
     };
     return CheckLimitWritingEvent(param, domain, eventName, info);
 }
+
+uint64_t WriteController::CheckLimitWritingEvent(const ControlParam& param, const char* domain,
+    const char* eventName, const char* func, CallSiteRecord& record)
+{
+    return CheckLimitByRecord(param, domain, eventName, func, GetCurrentTimeMills(), record);
+}
 } // HiviewDFX
-} // OHOS
\ No newline at end of file
+} // OHOS
@@ -16,6 +16,7 @@
 #include "easy_socket_writer.h"
 
 #include <errno.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -30,7 +31,10 @@
 extern "C" {
 #endif
 
-static const char SOCKET_PATH[] = "/dev/unix/socket/hisysevent";
+#define DEFAULT_SOCKET_PATH "/dev/unix/socket/hisysevent"
+
+static char g_socketPath[sizeof(((struct sockaddr_un*)0)->sun_path)] = DEFAULT_SOCKET_PATH;
+static pthread_mutex_t g_socketPathMutex = PTHREAD_MUTEX_INITIALIZER;
 
 static int InitSendBuffer(int socketId)
 {
@@ -50,8 +54,11 @@ static int InitSocket(struct sockaddr_un* socketAddr)
     if (ret != SUCCESS) {
         return ret;
     }
-    ret = MemoryCopy((uint8_t*)(socketAddr->sun_path), sizeof(socketAddr->sun_path), (uint8_t*)SOCKET_PATH,
-        strlen(SOCKET_PATH));
+    // the path may be set by other threads while it is copied
+    (void)pthread_mutex_lock(&g_socketPathMutex);
+    ret = MemoryCopy((uint8_t*)(socketAddr->sun_path), sizeof(socketAddr->sun_path), (uint8_t*)g_socketPath,
+        strlen(g_socketPath));
+    (void)pthread_mutex_unlock(&g_socketPathMutex);
     if (ret != SUCCESS) {
         return ret;
     }
@@ -59,6 +66,24 @@ static int InitSocket(struct sockaddr_un* socketAddr)
     return SUCCESS;
 }
 
+int HiSysEventEasySetSocketPath(const char* path)
+{
+    if (path == NULL) {
+        path = DEFAULT_SOCKET_PATH;
+    }
+    size_t pathLen = strlen(path);
+    if (pathLen == 0 || pathLen >= sizeof(g_socketPath)) {
+        return ERR_SOCKET_ADDR_INVALID;
+    }
+    (void)pthread_mutex_lock(&g_socketPathMutex);
+    int ret = MemoryInit((uint8_t*)g_socketPath, sizeof(g_socketPath));
+    if (ret == SUCCESS) {
+        ret = MemoryCopy((uint8_t*)g_socketPath, sizeof(g_socketPath), (uint8_t*)path, pathLen);
+    }
+    (void)pthread_mutex_unlock(&g_socketPathMutex);
+    return ret;
+}
+
 int Write(const uint8_t* data, const size_t dataLen)
 {
     if (data == NULL) {
@@ -23,6 +23,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Set path of socket which events are written to, events being written by other threads are sent to
+ *     either the former path or the new one
+ *
+ * @param path  path of socket listened by a local receiver, NULL means the default one listened by hiview
+ * @return 0 means success, others means failure.
+ */
+int HiSysEventEasySetSocketPath(const char* path);
+
 /**
  * @brief Write event to socket
  *
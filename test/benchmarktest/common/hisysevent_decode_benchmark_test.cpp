@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "def.h"
+#include "encoded_param.h"
+#include "raw_data.h"
+#include "raw_data_base_def.h"
+#include "raw_data_decoder.h"
+#include "raw_data_encoder.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+constexpr size_t PARAM_CNT_OF_MEDIUM_EVENT = 20;
+constexpr size_t ARRAY_STRING_LENGTH = 32;
+
+enum EventShape {
+    TINY = 0,           // 1 integer
+    MEDIUM = 1,         // 20 parameters of integer, floating number and short string
+    LARGE_STRING = 2,   // 1 string of max length
+    MAX_ARRAYS = 3,     // arrays of integer, double and string with max count of items
+};
+
+struct EventCorpus {
+    std::string largeString = std::string(MAX_STRING_LENGTH, 'a');
+    std::vector<int64_t> intArray = std::vector<int64_t>(MAX_ARRAY_SIZE, INT32_MAX);
+    std::vector<double> doubleArray = std::vector<double>(MAX_ARRAY_SIZE, 0.5); // 0.5 is a test value
+    std::vector<std::string> stringArray = std::vector<std::string>(MAX_ARRAY_SIZE,
+        std::string(ARRAY_STRING_LENGTH, 'a'));
+};
+
+bool MediumParamsEncoded(RawData& data, size_t& paramCnt)
+{
+    static const std::vector<std::string> keys = [] {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < PARAM_CNT_OF_MEDIUM_EVENT; ++i) {
+            names.push_back("KEY_" + std::to_string(i));
+        }
+        return names;
+    }();
+    constexpr char module[] = "hiview";
+    constexpr size_t paramKinds = 4; // 4: int64, uint64, double and string
+    bool ret = true;
+    for (size_t i = 0; i < PARAM_CNT_OF_MEDIUM_EVENT && ret; ++i) {
+        switch (i % paramKinds) {
+            case 0: // 0: int64
+                ret = ParamEncoder::ParamEncoded(data, keys[i], -static_cast<int64_t>(i));
+                break;
+            case 1: // 1: uint64
+                ret = ParamEncoder::ParamEncoded(data, keys[i], static_cast<uint64_t>(i) << 32); // 32: large value
+                break;
+            case 2: // 2: double
+                ret = ParamEncoder::ParamEncoded(data, keys[i], static_cast<double>(i) / paramKinds);
+                break;
+            default:
+                ret = ParamEncoder::ParamEncoded(data, keys[i], EscapedString { module, sizeof(module) - 1 });
+                break;
+        }
+    }
+    paramCnt = PARAM_CNT_OF_MEDIUM_EVENT;
+    return ret;
+}
+
+bool ParamsEncoded(RawData& data, int64_t shape, const EventCorpus& corpus, size_t& paramCnt)
+{
+    switch (shape) {
+        case EventShape::TINY:
+            paramCnt = 1;
+            return ParamEncoder::ParamEncoded(data, "PID", static_cast<int64_t>(1000)); // 1000: test pid
+        case EventShape::MEDIUM:
+            return MediumParamsEncoded(data, paramCnt);
+        case EventShape::LARGE_STRING:
+            paramCnt = 1;
+            return ParamEncoder::ParamEncoded(data, "STACK",
+                EscapedString { corpus.largeString.c_str(), corpus.largeString.length() });
+        default:
+            paramCnt = 3; // 3: arrays of integer, double and string
+            return ParamEncoder::ArrayParamEncoded<int64_t>(data, "INTS", corpus.intArray.begin(),
+                corpus.intArray.size()) &&
+                ParamEncoder::ArrayParamEncoded<double>(data, "DOUBLES", corpus.doubleArray.begin(),
+                corpus.doubleArray.size()) &&
+                ParamEncoder::ArrayParamEncoded<std::string>(data, "STRS", corpus.stringArray.begin(),
+                corpus.stringArray.size());
+    }
+}
+
+// same layout as the event written by HiSysEvent::EventBase
+template<typename F>
+bool EventEncoded(RawData& data, F paramsEncoded)
+{
+    data.Reset();
+    HiSysEventHeader header = { "DOMAIN", "EVENT_NAME", 0, 0, 0, 0, 0, 0, 3, 0 }; // 3: BEHAVIOR
+    int32_t blockSize = 0;
+    int32_t paramCnt = 0;
+    size_t paramCntOffset = sizeof(int32_t) + sizeof(struct HiSysEventHeader);
+    size_t encodedParamCnt = 0;
+    if (!data.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t)) ||
+        !data.Append(reinterpret_cast<uint8_t*>(&header), sizeof(struct HiSysEventHeader)) ||
+        !data.Append(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(int32_t)) ||
+        !paramsEncoded(data, encodedParamCnt)) {
+        return false;
+    }
+    blockSize = static_cast<int32_t>(data.GetDataLength());
+    paramCnt = static_cast<int32_t>(encodedParamCnt);
+    return data.Update(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t), 0) &&
+        data.Update(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(int32_t), paramCntOffset);
+}
+
+bool EventEncoded(RawData& data, int64_t shape, const EventCorpus& corpus)
+{
+    return EventEncoded(data, [shape, &corpus] (RawData& data, size_t& paramCnt) {
+        return ParamsEncoded(data, shape, corpus, paramCnt);
+    });
+}
+
+struct DecodedItems {
+    std::vector<uint64_t> uint64Items;
+    std::vector<int64_t> int64Items;
+    std::vector<double> doubleItems;
+    std::vector<std::string_view> stringItems;
+};
+
+// decode all parameters and items of arrays, return the count of parameters decoded or -1 if malformed
+int64_t EventDecoded(const RawData& data, DecodedItems& items)
+{
+    RawDataDecoder decoder;
+    if (!decoder.Init(data.GetData(), data.GetDataLength())) {
+        return -1;
+    }
+    int64_t paramCnt = 0;
+    DecodedParam param;
+    while (decoder.NextParam(param)) {
+        ++paramCnt;
+        if (!param.isArray) {
+            benchmark::DoNotOptimize(param);
+            continue;
+        }
+        bool ret = false;
+        if (param.valueType == ValueType::UINT64) {
+            ret = RawDataDecoder::ArrayItemsDecoded(param, items.uint64Items);
+        } else if (param.valueType == ValueType::INT64) {
+            ret = RawDataDecoder::ArrayItemsDecoded(param, items.int64Items);
+        } else if (param.valueType == ValueType::DOUBLE) {
+            ret = RawDataDecoder::ArrayItemsDecoded(param, items.doubleItems);
+        } else if (param.valueType == ValueType::STRING) {
+            ret = RawDataDecoder::ArrayItemsDecoded(param, items.stringItems);
+        }
+        if (!ret) {
+            return -1;
+        }
+    }
+    return decoder.IsMalformed() ? -1 : paramCnt;
+}
+
+bool IsRoundTripped(const RawData& data, int64_t shape)
+{
+    DecodedItems items;
+    int64_t paramCnt = EventDecoded(data, items);
+    switch (shape) {
+        case EventShape::MEDIUM:
+            return paramCnt == PARAM_CNT_OF_MEDIUM_EVENT;
+        case EventShape::MAX_ARRAYS:
+            return paramCnt == 3 && items.int64Items.size() == MAX_ARRAY_SIZE && // 3: count of arrays
+                items.doubleItems.size() == MAX_ARRAY_SIZE && items.stringItems.size() == MAX_ARRAY_SIZE;
+        default:
+            return paramCnt == 1;
+    }
+}
+}
+
+static void EncodeEvent(benchmark::State& state)
+{
+    EventCorpus corpus;
+    RawData data;
+    data.Reserve(MAX_DATA_SIZE);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(EventEncoded(data, state.range(0), corpus));
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.counters["EncodedSize"] = static_cast<double>(data.GetDataLength());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(data.GetDataLength()));
+}
+BENCHMARK(EncodeEvent)->Arg(TINY)->Arg(MEDIUM)->Arg(LARGE_STRING)->Arg(MAX_ARRAYS);
+
+static void DecodeEvent(benchmark::State& state)
+{
+    EventCorpus corpus;
+    RawData data;
+    if (!EventEncoded(data, state.range(0), corpus) || !IsRoundTripped(data, state.range(0))) {
+        state.SkipWithError("decoded event mismatches with the one encoded");
+        return;
+    }
+    // vectors of items are reused as the receiver does
+    DecodedItems items;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(EventDecoded(data, items));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(data.GetDataLength()));
+}
+BENCHMARK(DecodeEvent)->Arg(TINY)->Arg(MEDIUM)->Arg(LARGE_STRING)->Arg(MAX_ARRAYS);
+
+static void DecodePackedDoubleArray(benchmark::State& state)
+{
+    // arg 0 means items are encoded one by one, otherwise they are packed
+    RawDataEncoder::SetPackedArrayEnabled(state.range(0) != 0);
+    EventCorpus corpus;
+    RawData data;
+    bool ret = EventEncoded(data, [&corpus] (RawData& data, size_t& paramCnt) {
+        paramCnt = 1;
+        return ParamEncoder::ArrayParamEncoded<double>(data, "DOUBLES", corpus.doubleArray.begin(),
+            corpus.doubleArray.size());
+    });
+    RawDataEncoder::SetPackedArrayEnabled(false);
+    RawDataDecoder decoder;
+    DecodedParam param;
+    if (!ret || !decoder.Init(data.GetData(), data.GetDataLength()) || !decoder.NextParam(param)) {
+        state.SkipWithError("failed to decode the array encoded");
+        return;
+    }
+    std::vector<double> items;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RawDataDecoder::ArrayItemsDecoded(param, items));
+        benchmark::DoNotOptimize(items.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MAX_ARRAY_SIZE);
+}
+BENCHMARK(DecodePackedDoubleArray)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
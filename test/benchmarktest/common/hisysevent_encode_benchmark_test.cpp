@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "def.h"
+#include "encoded_param.h"
+#include "hisysevent_schema.h"
+#include "raw_data.h"
+#include "raw_data_encoder.h"
+#include "stringfilter.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+constexpr size_t APPEND_UNIT_SIZE = 64;
+constexpr size_t LARGE_EVENT_RESERVED_SIZE = 1024; // reserved for header and keys of the large event
+constexpr size_t SPARSE_ESCAPE_INTERVAL = 64; // a line break for each line of stack
+constexpr size_t DENSE_ESCAPE_INTERVAL = 4;
+
+constexpr char KEY_PID[] = "PID";
+constexpr char KEY_UID[] = "UID";
+constexpr char KEY_MODULE[] = "MODULE";
+constexpr char KEY_DURATION[] = "DURATION";
+constexpr int64_t PID = 1000;
+constexpr uint64_t UID = 20010000;
+constexpr double DURATION = 3.5;
+
+enum VarintCorpus {
+    SMALL_VARINT = 0,
+    MEDIUM_VARINT = 1,
+    LARGE_VARINT = 2,
+};
+
+enum EscapeCorpus {
+    CLEAN = 0,
+    SPARSE_ESCAPE = 1,
+    DENSE_ESCAPE = 2,
+};
+
+std::vector<std::string> GetLargeStringArray()
+{
+    // MAX_ARRAY_SIZE strings which total to nearly MAX_DATA_SIZE bytes
+    size_t itemSize = (MAX_DATA_SIZE - LARGE_EVENT_RESERVED_SIZE) / MAX_ARRAY_SIZE;
+    return std::vector<std::string>(MAX_ARRAY_SIZE, std::string(itemSize, 'a'));
+}
+
+std::string GetEscapeCorpus(size_t len, int64_t corpus)
+{
+    std::string text(len, 'a');
+    size_t interval = (corpus == EscapeCorpus::SPARSE_ESCAPE) ? SPARSE_ESCAPE_INTERVAL : DENSE_ESCAPE_INTERVAL;
+    if (corpus == EscapeCorpus::CLEAN) {
+        return text;
+    }
+    for (size_t pos = interval - 1; pos < len; pos += interval) {
+        text[pos] = (pos % 2 == 0) ? '\n' : '\"'; // 2: alternate the chars to escape
+    }
+    return text;
+}
+
+std::vector<int64_t> GetVarintCorpus(int64_t corpus)
+{
+    constexpr unsigned int smallBitCnt = 5;
+    constexpr unsigned int mediumBitCnt = 32;
+    std::mt19937_64 engine(MAX_ARRAY_SIZE);
+    std::vector<int64_t> values(MAX_ARRAY_SIZE);
+    for (auto& val : values) {
+        uint64_t bits = engine();
+        if (corpus == VarintCorpus::SMALL_VARINT) {
+            bits >>= (std::numeric_limits<uint64_t>::digits - smallBitCnt + 1); // 1: sign bit
+        } else if (corpus == VarintCorpus::MEDIUM_VARINT) {
+            bits >>= (std::numeric_limits<uint64_t>::digits - mediumBitCnt);
+        }
+        val = static_cast<int64_t>(bits);
+    }
+    return values;
+}
+
+// same as RawDataEncoder::SignedVarintEncoded before the varints of array are encoded together
+bool LegacyVarintEncoded(RawData& data, int64_t val)
+{
+    constexpr uint64_t tagByteBound = 0x20;
+    constexpr uint64_t nonTagByteBound = 0x80;
+    constexpr unsigned int tagByteOffset = 5;
+    constexpr unsigned int nonTagByteOffset = 7;
+    uint64_t signMask = (val >= 0) ? 0 : std::numeric_limits<uint64_t>::max();
+    uint64_t uval = (static_cast<uint64_t>(val) << 1) ^ signMask;
+    uint8_t cpyVal = static_cast<uint8_t>((static_cast<uint8_t>(EncodeType::VARINT) << (tagByteOffset + 1)) |
+        ((uval < tagByteBound) ? 0 : tagByteBound) | (uval & (tagByteBound - 1)));
+    if (!data.Append(&cpyVal, 1)) {
+        return false;
+    }
+    for (uval >>= tagByteOffset; uval > 0; uval >>= nonTagByteOffset) {
+        cpyVal = static_cast<uint8_t>(((uval < nonTagByteBound) ? 0 : nonTagByteBound) |
+            (uval & (nonTagByteBound - 1)));
+        if (!data.Append(&cpyVal, 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// same as StringFilter::EscapeToRaw before the chars to escape are scanned by SIMD
+std::string LegacyEscapeToRaw(const std::string& text)
+{
+    constexpr int charRange = 128;
+    static const std::vector<std::string> charTab = [] {
+        std::vector<std::string> tab(charRange);
+        tab['\\'] = "\\\\";
+        tab['\"'] = "\\\"";
+        tab['\b'] = "\\b";
+        tab['\f'] = "\\f";
+        tab['\n'] = "\\n";
+        tab['\r'] = "\\r";
+        tab['\t'] = "\\t";
+        return tab;
+    }();
+    std::string rawText = "";
+    for (auto c : text) {
+        int ic = static_cast<int>(c);
+        if (ic >= 0 && ic < charRange && !charTab[ic].empty()) {
+            rawText.append(charTab[ic]);
+            continue;
+        }
+        if ((ic == 0x7F) || (ic >= 0x00 && ic <= 0x1F)) {
+            continue;
+        }
+        rawText.push_back(c);
+    }
+    return rawText;
+}
+
+// same as StringFilter::IsValidName before the chars are checked by SIMD
+bool LegacyIsValidName(const std::string& text, unsigned int maxSize)
+{
+    constexpr int charRange = 128;
+    static constexpr int stateBegin = 0;
+    static constexpr int stateRun = 1;
+    static constexpr int stateStop = -1;
+    static const std::vector<std::vector<int>> statTab = [] {
+        std::vector<std::vector<int>> tab(2, std::vector<int>(charRange, stateStop)); // 2: count of states
+        for (int i = 0; i < charRange; ++i) {
+            bool isLetter = (i >= 'a' && i <= 'z') || (i >= 'A' && i <= 'Z');
+            tab[stateBegin][i] = isLetter ? stateRun : stateStop;
+            tab[stateRun][i] = (isLetter || (i >= '0' && i <= '9') || (i == '_')) ? stateRun : stateStop;
+        }
+        return tab;
+    }();
+    if (text.empty() || text.length() > maxSize) {
+        return false;
+    }
+    int state = stateBegin;
+    for (auto c : text) {
+        unsigned int ic = static_cast<unsigned int>(c);
+        if (ic >= charRange) {
+            return false;
+        }
+        state = statTab[state][ic];
+        if (state == stateStop) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+static void RawDataAppend(benchmark::State& state)
+{
+    uint8_t unit[APPEND_UNIT_SIZE] = { 0 };
+    size_t totalSize = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        RawData data;
+        for (size_t appendedSize = 0; appendedSize < totalSize; appendedSize += APPEND_UNIT_SIZE) {
+            data.Append(unit, APPEND_UNIT_SIZE);
+        }
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(RawDataAppend)->Arg(4 * 1024)->Arg(64 * 1024)->Arg(MAX_DATA_SIZE); // 4K, 64K and 384K bytes
+
+static void EncodeLargeEvent(benchmark::State& state)
+{
+    auto vals = GetLargeStringArray();
+    for (auto _ : state) {
+        RawData data;
+        ParamEncoder::ArrayParamEncoded<std::string>(data, "KEY", vals.begin(), vals.size());
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+BENCHMARK(EncodeLargeEvent);
+
+static void EncodeLargeEventWithReserved(benchmark::State& state)
+{
+    auto vals = GetLargeStringArray();
+    for (auto _ : state) {
+        RawData data;
+        data.Reserve(MAX_DATA_SIZE);
+        ParamEncoder::ArrayParamEncoded<std::string>(data, "KEY", vals.begin(), vals.size());
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+BENCHMARK(EncodeLargeEventWithReserved);
+
+static void CopyLargeEvent(benchmark::State& state)
+{
+    auto vals = GetLargeStringArray();
+    RawData data;
+    ParamEncoder::ArrayParamEncoded<std::string>(data, "KEY", vals.begin(), vals.size());
+    for (auto _ : state) {
+        RawData copied(data);
+        benchmark::DoNotOptimize(copied.GetData());
+    }
+}
+BENCHMARK(CopyLargeEvent);
+
+static void MoveLargeEvent(benchmark::State& state)
+{
+    auto vals = GetLargeStringArray();
+    RawData data;
+    ParamEncoder::ArrayParamEncoded<std::string>(data, "KEY", vals.begin(), vals.size());
+    for (auto _ : state) {
+        RawData moved(std::move(data));
+        data = std::move(moved);
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+BENCHMARK(MoveLargeEvent);
+
+static void EncodeStringByLegacyEscape(benchmark::State& state)
+{
+    auto text = GetEscapeCorpus(MAX_STRING_LENGTH, state.range(0));
+    RawData data;
+    data.Reserve(MAX_DATA_SIZE);
+    for (auto _ : state) {
+        data.Reset();
+        ParamEncoder::ParamEncoded(data, "KEY", LegacyEscapeToRaw(std::string(text.c_str())));
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * MAX_STRING_LENGTH);
+}
+BENCHMARK(EncodeStringByLegacyEscape)->Arg(CLEAN)->Arg(SPARSE_ESCAPE)->Arg(DENSE_ESCAPE);
+
+static void EncodeStringByEscape(benchmark::State& state)
+{
+    auto text = GetEscapeCorpus(MAX_STRING_LENGTH, state.range(0));
+    RawData data;
+    data.Reserve(MAX_DATA_SIZE);
+    for (auto _ : state) {
+        data.Reset();
+        ParamEncoder::ParamEncoded(data, "KEY", StringFilter::GetInstance().EscapeToRaw(text));
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * MAX_STRING_LENGTH);
+}
+BENCHMARK(EncodeStringByEscape)->Arg(CLEAN)->Arg(SPARSE_ESCAPE)->Arg(DENSE_ESCAPE);
+
+static void EncodeStringByEscapeInPlace(benchmark::State& state)
+{
+    auto text = GetEscapeCorpus(MAX_STRING_LENGTH, state.range(0));
+    RawData data;
+    data.Reserve(MAX_DATA_SIZE);
+    for (auto _ : state) {
+        data.Reset();
+        ParamEncoder::ParamEncoded(data, "KEY", EscapedString { text.c_str(), text.length() });
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * MAX_STRING_LENGTH);
+}
+BENCHMARK(EncodeStringByEscapeInPlace)->Arg(CLEAN)->Arg(SPARSE_ESCAPE)->Arg(DENSE_ESCAPE);
+
+static void ValidateNameByLegacyDfa(benchmark::State& state)
+{
+    std::string name = "K" + std::string(state.range(0) - 1, '_');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LegacyIsValidName(name, MAX_PARAM_NAME_LENGTH));
+    }
+}
+BENCHMARK(ValidateNameByLegacyDfa)->Arg(8)->Arg(16)->Arg(32)->Arg(MAX_PARAM_NAME_LENGTH); // 8, 16, 32: name length
+
+static void ValidateName(benchmark::State& state)
+{
+    std::string name = "K" + std::string(state.range(0) - 1, '_');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StringFilter::GetInstance().IsValidName(name, MAX_PARAM_NAME_LENGTH));
+    }
+}
+BENCHMARK(ValidateName)->Arg(8)->Arg(16)->Arg(32)->Arg(MAX_PARAM_NAME_LENGTH); // 8, 16, 32: name length
+
+static void EncodeInt64ArrayByItem(benchmark::State& state)
+{
+    auto values = GetVarintCorpus(state.range(0));
+    for (auto _ : state) {
+        RawData data;
+        bool ret = RawDataEncoder::UnsignedVarintEncoded(data, EncodeType::LENGTH_DELIMITED, values.size());
+        for (auto val : values) {
+            ret = ret && LegacyVarintEncoded(data, val);
+        }
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MAX_ARRAY_SIZE);
+}
+BENCHMARK(EncodeInt64ArrayByItem)->Arg(SMALL_VARINT)->Arg(MEDIUM_VARINT)->Arg(LARGE_VARINT);
+
+static void EncodeInt64Array(benchmark::State& state)
+{
+    auto values = GetVarintCorpus(state.range(0));
+    for (auto _ : state) {
+        RawData data;
+        benchmark::DoNotOptimize(ParamEncoder::ArrayValueEncoded<int64_t>(data, values.begin(), values.size()));
+        benchmark::DoNotOptimize(data.GetData());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MAX_ARRAY_SIZE);
+}
+BENCHMARK(EncodeInt64Array)->Arg(SMALL_VARINT)->Arg(MEDIUM_VARINT)->Arg(LARGE_VARINT);
+
+static void EncodeDoubleArray(benchmark::State& state)
+{
+    // arg 0 means items are encoded one by one, otherwise they are packed
+    RawDataEncoder::SetPackedArrayEnabled(state.range(0) != 0);
+    std::vector<double> values(MAX_ARRAY_SIZE, 0.5); // 0.5 is a test value
+    size_t encodedSize = 0;
+    for (auto _ : state) {
+        RawData data;
+        benchmark::DoNotOptimize(ParamEncoder::ArrayParamEncoded<double>(data, "KEY", values.begin(),
+            values.size()));
+        encodedSize = data.GetDataLength();
+    }
+    RawDataEncoder::SetPackedArrayEnabled(false);
+    state.counters["EncodedSize"] = static_cast<double>(encodedSize);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MAX_ARRAY_SIZE);
+}
+BENCHMARK(EncodeDoubleArray)->Arg(0)->Arg(1);
+
+static void EncodeParamsByKey(benchmark::State& state)
+{
+    // keys are validated and encoded while writing, same as HiSysEventWrite
+    auto& filter = StringFilter::GetInstance();
+    std::string module = "hiview";
+    for (auto _ : state) {
+        RawData data;
+        bool ret = filter.IsValidName(KEY_PID, MAX_PARAM_NAME_LENGTH) &&
+            ParamEncoder::ParamEncoded(data, KEY_PID, PID);
+        ret = ret && filter.IsValidName(KEY_UID, MAX_PARAM_NAME_LENGTH) &&
+            ParamEncoder::ParamEncoded(data, KEY_UID, UID);
+        ret = ret && filter.IsValidName(KEY_MODULE, MAX_PARAM_NAME_LENGTH) &&
+            ParamEncoder::ParamEncoded(data, KEY_MODULE, EscapedString { module.c_str(), module.length() });
+        ret = ret && filter.IsValidName(KEY_DURATION, MAX_PARAM_NAME_LENGTH) &&
+            ParamEncoder::ParamEncoded(data, KEY_DURATION, DURATION);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+BENCHMARK(EncodeParamsByKey);
+
+template<typename Key, typename T>
+bool EncodeBySchemaKey(RawData& data, const T& value)
+{
+    return data.Append(const_cast<uint8_t*>(Key::ENCODED_KEY.data()), Key::ENCODED_KEY.size()) &&
+        ParamEncoder::ValueEncoded(data, value);
+}
+
+static void EncodeParamsBySchemaKey(benchmark::State& state)
+{
+    // keys are validated and encoded at compile time, same as HiSysEventSchema::Write
+    std::string module = "hiview";
+    for (auto _ : state) {
+        RawData data;
+        bool ret = EncodeBySchemaKey<HiSysEventSchemaKey<KEY_PID, int64_t>>(data, PID);
+        ret = ret && EncodeBySchemaKey<HiSysEventSchemaKey<KEY_UID, uint64_t>>(data, UID);
+        ret = ret && EncodeBySchemaKey<HiSysEventSchemaKey<KEY_MODULE, std::string>>(data,
+            EscapedString { module.c_str(), module.length() });
+        ret = ret && EncodeBySchemaKey<HiSysEventSchemaKey<KEY_DURATION, double>>(data, DURATION);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+BENCHMARK(EncodeParamsBySchemaKey);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// events written by the benchmarks below are never discarded by the frequency control
+#define HISYSEVENT_PERIOD 1
+#define HISYSEVENT_THRESHOLD SIZE_MAX
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "easy_socket_writer.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_easy.h"
+#include "mock_event_receiver.h"
+
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char EVENT_NAME[] = "BENCHMARK";
+constexpr char KEY_SEND_TIME[] = "SEND_TIME";
+constexpr char KEY_MODULE[] = "MODULE";
+constexpr char MODULE[] = "hiview";
+constexpr char DEVICE_TMP_DIR[] = "/data/local/tmp";
+constexpr char HOST_TMP_DIR[] = "/tmp";
+constexpr uint32_t RECEIVE_TIMEOUT = 3000; // 3s to receive the events sent
+constexpr double P50 = 0.5;
+constexpr double P99 = 0.99;
+constexpr double P999 = 0.999;
+
+std::atomic<uint64_t> g_sentCnt { 0 };
+
+MockEventReceiver* GetReceiver()
+{
+    static std::unique_ptr<MockEventReceiver> receiver = [] {
+        std::string dir = (access(DEVICE_TMP_DIR, W_OK) == 0) ? DEVICE_TMP_DIR : HOST_TMP_DIR;
+        std::string path = dir + "/hisysevent_bench_" + std::to_string(getpid());
+        auto mockReceiver = std::make_unique<MockEventReceiver>(path);
+        mockReceiver->SetSendTimeKey(KEY_SEND_TIME);
+        // events with higher priority are not written by the benchmarks, so only the normal socket is listened
+        if (!mockReceiver->Start() || !EventSocketFactory::SetSocketPath(path, path + "_fast") ||
+            HiSysEventEasySetSocketPath(path.c_str()) != 0) {
+            return std::unique_ptr<MockEventReceiver>();
+        }
+        return mockReceiver;
+    }();
+    return receiver.get();
+}
+
+uint64_t GetPercentile(std::vector<uint64_t>& values, double percentile)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    auto index = static_cast<size_t>(percentile * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+int WriteEvent()
+{
+    std::string module = MODULE;
+    return HiSysEventWrite(DOMAIN, EVENT_NAME, HiSysEvent::EventType::BEHAVIOR,
+        KEY_SEND_TIME, MockEventReceiver::GetMonotonicTimeNanos(), KEY_MODULE, module);
+}
+
+// the receiver is reset by the first thread before all threads begin to write
+bool BeginWriting(benchmark::State& state)
+{
+    auto receiver = GetReceiver();
+    if (receiver == nullptr) {
+        state.SkipWithError("failed to start the mock receiver");
+        return false;
+    }
+    if (state.thread_index() == 0) {
+        receiver->Reset();
+        g_sentCnt = 0;
+    }
+    return true;
+}
+
+// the events sent are waited by the first thread after all threads finish writing
+void EndWriting(benchmark::State& state)
+{
+    if (state.thread_index() != 0) {
+        return;
+    }
+    auto receiver = GetReceiver();
+    uint64_t sentCnt = g_sentCnt;
+    (void)receiver->WaitForCount(sentCnt, RECEIVE_TIMEOUT);
+    uint64_t receivedCnt = std::min(receiver->GetReceivedCount(), sentCnt);
+    state.counters["DropRate"] = (sentCnt == 0) ? 0 :
+        static_cast<double>(sentCnt - receivedCnt) / static_cast<double>(sentCnt);
+    state.counters["Malformed"] = static_cast<double>(receiver->GetMalformedCount());
+    auto latencies = receiver->GetLatencies();
+    state.counters["DeliveryP50Ns"] = static_cast<double>(GetPercentile(latencies, P50));
+    state.counters["DeliveryP99Ns"] = static_cast<double>(GetPercentile(latencies, P99));
+    state.counters["DeliveryP999Ns"] = static_cast<double>(GetPercentile(latencies, P999));
+}
+}
+
+static void WriteEventLatency(benchmark::State& state)
+{
+    if (!BeginWriting(state)) {
+        return;
+    }
+    std::vector<uint64_t> latencies;
+    latencies.reserve(state.max_iterations);
+    for (auto _ : state) {
+        uint64_t begin = MockEventReceiver::GetMonotonicTimeNanos();
+        int ret = WriteEvent();
+        latencies.push_back(MockEventReceiver::GetMonotonicTimeNanos() - begin);
+        if (ret == SUCCESS) {
+            g_sentCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    state.counters["WriteP50Ns"] = static_cast<double>(GetPercentile(latencies, P50));
+    state.counters["WriteP99Ns"] = static_cast<double>(GetPercentile(latencies, P99));
+    state.counters["WriteP999Ns"] = static_cast<double>(GetPercentile(latencies, P999));
+    EndWriting(state);
+}
+BENCHMARK(WriteEventLatency);
+
+static void WriteEventThroughput(benchmark::State& state)
+{
+    if (!BeginWriting(state)) {
+        return;
+    }
+    for (auto _ : state) {
+        if (WriteEvent() == SUCCESS) {
+            g_sentCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    EndWriting(state);
+}
+BENCHMARK(WriteEventThroughput)->ThreadRange(1, 8)->UseRealTime(); // 1 to 8 threads to write concurrently
+
+static void WriteEventUnderBackpressure(benchmark::State& state)
+{
+    if (!BeginWriting(state)) {
+        return;
+    }
+    // arg is the delay in microseconds of the receiver to handle each event
+    GetReceiver()->SetHandleDelay(static_cast<uint32_t>(state.range(0)));
+    uint64_t failedCnt = 0;
+    for (auto _ : state) {
+        if (WriteEvent() == SUCCESS) {
+            g_sentCnt.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            failedCnt++;
+        }
+    }
+    state.counters["FailRate"] = benchmark::Counter(static_cast<double>(failedCnt),
+        benchmark::Counter::kAvgIterations);
+    EndWriting(state);
+    GetReceiver()->SetHandleDelay(0);
+}
+// 0, 10 and 100 microseconds to handle each event, and 20000 events are written by each round
+BENCHMARK(WriteEventUnderBackpressure)->Arg(0)->Arg(10)->Arg(100)->Iterations(20000)->UseRealTime();
+
+static void EasyWriteEventThroughput(benchmark::State& state)
+{
+    if (!BeginWriting(state)) {
+        return;
+    }
+    for (auto _ : state) {
+        if (OH_HiSysEvent_Easy_Write(DOMAIN, EVENT_NAME, EASY_EVENT_TYPE_BEHAVIOR, MODULE) == 0) {
+            g_sentCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    EndWriting(state);
+}
+BENCHMARK(EasyWriteEventThroughput)->ThreadRange(1, 8)->UseRealTime(); // 1 to 8 threads to write concurrently
+
+static void WriteFaultEventUnderFlood(benchmark::State& state)
+{
+    if (!BeginWriting(state)) {
+        return;
+    }
+    // arg 0 means all events are queued together, otherwise FAULT events are queued by a lane of their own
+    constexpr uint32_t queueDepth = 256;
+    if (state.range(0) == 0) {
+        HiSysEvent::SetAsyncMode(true, queueDepth, AsyncDropPolicy::DROP_NEWEST);
+    } else {
+        (void)HiSysEvent::SetAsyncPriorityLanes({
+            { queueDepth, AsyncDropPolicy::DROP_NEWEST, { std::string(DOMAIN) + " * FAULT" } },
+            { queueDepth, AsyncDropPolicy::DROP_NEWEST, {} },
+        });
+    }
+    // STATISTIC events without send time are written as fast as possible by another thread
+    std::atomic<bool> isFlooding { true };
+    std::thread flood([&isFlooding] {
+        while (isFlooding.load(std::memory_order_relaxed)) {
+            (void)HiSysEventWrite(DOMAIN, EVENT_NAME, HiSysEvent::EventType::STATISTIC, KEY_MODULE, MODULE);
+        }
+    });
+    GetReceiver()->SetHandleDelay(10); // 10us to handle each event, so that the queue is always full
+    for (auto _ : state) {
+        std::string module = MODULE;
+        if (HiSysEventWrite(DOMAIN, EVENT_NAME, HiSysEvent::EventType::FAULT, KEY_SEND_TIME,
+            MockEventReceiver::GetMonotonicTimeNanos(), KEY_MODULE, module) == SUCCESS) {
+            g_sentCnt.fetch_add(1, std::memory_order_relaxed);
+        }
+        state.PauseTiming();
+        std::this_thread::sleep_for(std::chrono::microseconds(100)); // 100us between FAULT events
+        state.ResumeTiming();
+    }
+    isFlooding = false;
+    flood.join();
+    GetReceiver()->SetHandleDelay(0);
+    HiSysEvent::SetAsyncMode(false);
+    // only FAULT events carry send time, so the delivery latencies are the ones of FAULT events
+    auto latencies = GetReceiver()->GetLatencies();
+    for (uint32_t waited = 0; latencies.size() < g_sentCnt && waited < RECEIVE_TIMEOUT; ++waited) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        latencies = GetReceiver()->GetLatencies();
+    }
+    state.counters["FaultDeliveryP50Ns"] = static_cast<double>(GetPercentile(latencies, P50));
+    state.counters["FaultDeliveryP99Ns"] = static_cast<double>(GetPercentile(latencies, P99));
+    state.counters["FaultLost"] = static_cast<double>(g_sentCnt - std::min<uint64_t>(latencies.size(), g_sentCnt));
+}
+// 2000 FAULT events are written by each round
+BENCHMARK(WriteFaultEventUnderFlood)->Arg(0)->Arg(1)->Iterations(2000)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <string>
+#include <unistd.h>
+
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "process_info_cache.h"
+#include "raw_data.h"
+#include "raw_data_base_def.h"
+#include "write_controller.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+constexpr size_t HEADER_RESERVED_SIZE = 256;
+
+// same as the construction of header in HiSysEvent::EventBase::WritebaseInfo before the identity is cached
+void BuildHeaderUncached(HiSysEventHeader& header)
+{
+    header.timestamp = WriteController::GetCurrentTimeMills();
+    header.timeZone = static_cast<uint8_t>(ParseTimeZone(timezone));
+    header.pid = static_cast<uint32_t>(getprocpid());
+    header.tid = static_cast<uint32_t>(getproctid());
+    header.uid = static_cast<uint32_t>(getuid());
+}
+
+void BuildHeaderCached(HiSysEventHeader& header)
+{
+    header.timestamp = WriteController::GetCurrentTimeMills();
+    header.timeZone = ProcessInfoCache::GetTimeZoneIndex();
+    header.pid = ProcessInfoCache::GetPid();
+    header.tid = ProcessInfoCache::GetTid();
+    header.uid = static_cast<uint32_t>(getuid());
+}
+
+template<typename F>
+void BuildHeader(benchmark::State& state, F build)
+{
+    RawData data;
+    data.Reserve(HEADER_RESERVED_SIZE);
+    for (auto _ : state) {
+        HiSysEventHeader header = { "DOMAIN", "EVENT_NAME", 0, 0, 0, 0, 0, 0, 3, 0 }; // 3: BEHAVIOR
+        build(header);
+        data.Reset();
+        int32_t blockSize = 0;
+        data.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t));
+        data.Append(reinterpret_cast<uint8_t*>(&header), sizeof(struct HiSysEventHeader));
+        benchmark::DoNotOptimize(data.GetData());
+    }
+}
+
+// same as the routing of EventSocketFactory before events are routed by hashes
+bool IsHigherPriorityEventByString(const std::string& domain, const std::string& name, int type)
+{
+    static std::list<std::string> aafwkEvents {
+        "APP_INPUT_BLOCK", "BUSSINESS_THREAD_BLOCK_3S", "BUSSINESS_THREAD_BLOCK_6S",
+        "LIFECYCLE_HALF_TIMEOUT", "LIFECYCLE_TIMEOUT", "THREAD_BLOCK_3S", "THREAD_BLOCK_6S" };
+    static std::list<std::string> aceEvents { "UI_BLOCK_3S", "UI_BLOCK_6S", "UI_BLOCK_RECOVERED" };
+    static std::list<std::string> frameworkEvents {
+        "IPC_FULL", "IPC_FULL_WARNING", "SERVICE_BLOCK", "SERVICE_TIMEOUT", "SERVICE_WARNING" };
+    auto isFound = [&name] (const std::list<std::string>& events) {
+        return std::find(events.begin(), events.end(), name) != events.end();
+    };
+    if (domain == "AAFWK") {
+        return isFound(aafwkEvents);
+    } else if (domain == "ACE") {
+        return isFound(aceEvents);
+    } else if (domain == "FRAMEWORK") {
+        return isFound(frameworkEvents);
+    } else if (domain == "RELIABILITY") {
+        return type == HiSysEvent::EventType::FAULT;
+    } else if (domain == "GRAPHIC") {
+        return name == "NO_DRAW";
+    } else if (domain == "MULTIMODALINPUT") {
+        return name == "TARGET_POINTER_EVENT_FAILURE";
+    } else if (domain == "POWER") {
+        return name == "SCREEN_ON_TIMEOUT";
+    } else if (domain == "WINDOWMANAGER") {
+        return name == "NO_FOCUS_WINDOW";
+    } else if (domain == "SCHEDULE_EXT") {
+        return name == "SYSTEM_LOAD_LEVEL_CHANGED";
+    }
+    return false;
+}
+
+const EventSocket& GetEventSocketByString(RawData& data)
+{
+    auto header = reinterpret_cast<const HiSysEventHeader*>(data.GetData() + sizeof(int32_t));
+    std::string domain(header->domain);
+    std::string name(header->name);
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    return EventSocketFactory::GetEventSocket(IsHigherPriorityEventByString(domain, name, type));
+}
+
+// arg 0 is an event with normal priority of a domain not configured, arg 1 is a configured one with higher priority
+RawData EventToRoute(int64_t arg)
+{
+    HiSysEventHeader header = { "HIVIEWDFX", "EVENT_NAME", 0, 0, 0, 0, 0, 0, 3, 0 }; // 3: BEHAVIOR
+    if (arg != 0) {
+        header = { "FRAMEWORK", "SERVICE_WARNING", 0, 0, 0, 0, 0, 0, 0, 0 }; // 0: FAULT
+    }
+    RawData data;
+    int32_t blockSize = 0;
+    data.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t));
+    data.Append(reinterpret_cast<uint8_t*>(&header), sizeof(struct HiSysEventHeader));
+    return data;
+}
+}
+
+static void BuildEventHeaderUncached(benchmark::State& state)
+{
+    BuildHeader(state, BuildHeaderUncached);
+}
+BENCHMARK(BuildEventHeaderUncached)->ThreadRange(1, 8); // 8: max count of threads
+
+static void BuildEventHeaderCached(benchmark::State& state)
+{
+    BuildHeader(state, BuildHeaderCached);
+}
+BENCHMARK(BuildEventHeaderCached)->ThreadRange(1, 8); // 8: max count of threads
+
+static void RouteEventByString(benchmark::State& state)
+{
+    RawData data = EventToRoute(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&GetEventSocketByString(data));
+    }
+}
+BENCHMARK(RouteEventByString)->Arg(0)->Arg(1);
+
+static void RouteEventByHash(benchmark::State& state)
+{
+    RawData data = EventToRoute(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&EventSocketFactory::GetEventSocket(data));
+    }
+}
+BENCHMARK(RouteEventByHash)->Arg(0)->Arg(1);
+
+static void RouteEventByName(benchmark::State& state)
+{
+    // the route is decided once by HiSysEvent::SendSysEvent from the domain, name and type it knows, without
+    // parsing the header, and reused by each attempt of sending
+    RawData data = EventToRoute(state.range(0));
+    auto header = reinterpret_cast<const HiSysEventHeader*>(data.GetData() + sizeof(int32_t));
+    std::string_view domain(header->domain);
+    std::string_view name(header->name);
+    int type = static_cast<int>(header->type) + 1; // transform type to HiSysEvent::EventType
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(EventSocketFactory::GetEventRoute(domain, name, type));
+    }
+}
+BENCHMARK(RouteEventByName)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <dlfcn.h>
+#include <securec.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "async_sender.h"
+#include "def.h"
+#include "event_socket_factory.h"
+#include "raw_data.h"
+#include "raw_data_base_def.h"
+#include "transport.h"
+
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+thread_local int64_t g_syscallCnt = 0;
+
+void BuildEvent(RawData& data, uint8_t type = 0)
+{
+    // event without any customized param, type in header is event type minus 1
+    struct HiSysEventHeader header = { "HIVIEWDFX", "BENCHMARK", 0, 0, 0, 0, 0, 0, type, 0 };
+    int32_t blockSize = static_cast<int32_t>(sizeof(int32_t) + sizeof(header) + sizeof(int32_t));
+    int32_t paramCnt = 0;
+    data.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t));
+    data.Append(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+    data.Append(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(int32_t));
+}
+
+template<typename F>
+F GetRealFunc(const char* name)
+{
+    return reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+}
+}
+
+// the socket related syscalls made by the hisysevent client are counted by the interposers below
+extern "C" {
+int socket(int domain, int type, int protocol)
+{
+    static auto realFunc = GetRealFunc<int (*)(int, int, int)>("socket");
+    g_syscallCnt++;
+    return realFunc(domain, type, protocol);
+}
+
+int connect(int fd, const struct sockaddr* addr, socklen_t len)
+{
+    static auto realFunc = GetRealFunc<int (*)(int, const struct sockaddr*, socklen_t)>("connect");
+    g_syscallCnt++;
+    return realFunc(fd, addr, len);
+}
+
+int getsockopt(int fd, int level, int name, void* val, socklen_t* len)
+{
+    static auto realFunc = GetRealFunc<int (*)(int, int, int, void*, socklen_t*)>("getsockopt");
+    g_syscallCnt++;
+    return realFunc(fd, level, name, val, len);
+}
+
+int setsockopt(int fd, int level, int name, const void* val, socklen_t len)
+{
+    static auto realFunc = GetRealFunc<int (*)(int, int, int, const void*, socklen_t)>("setsockopt");
+    g_syscallCnt++;
+    return realFunc(fd, level, name, val, len);
+}
+
+ssize_t send(int fd, const void* buf, size_t len, int flags)
+{
+    static auto realFunc = GetRealFunc<ssize_t (*)(int, const void*, size_t, int)>("send");
+    g_syscallCnt++;
+    return realFunc(fd, buf, len, flags);
+}
+
+ssize_t sendto(int fd, const void* buf, size_t len, int flags, const struct sockaddr* addr, socklen_t addrLen)
+{
+    static auto realFunc =
+        GetRealFunc<ssize_t (*)(int, const void*, size_t, int, const struct sockaddr*, socklen_t)>("sendto");
+    g_syscallCnt++;
+    return realFunc(fd, buf, len, flags, addr, addrLen);
+}
+
+int sendmmsg(int fd, struct mmsghdr* msgs, unsigned int cnt, int flags)
+{
+    static auto realFunc = GetRealFunc<int (*)(int, struct mmsghdr*, unsigned int, int)>("sendmmsg");
+    g_syscallCnt++;
+    return realFunc(fd, msgs, cnt, flags);
+}
+
+int close(int fd)
+{
+    static auto realFunc = GetRealFunc<int (*)(int)>("close");
+    g_syscallCnt++;
+    return realFunc(fd);
+}
+}
+
+static void SendEvent(benchmark::State& state)
+{
+    RawData data;
+    BuildEvent(data);
+    int64_t syscallCnt = g_syscallCnt;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Transport::GetInstance().SendData(data));
+    }
+    state.counters["syscalls"] = benchmark::Counter(static_cast<double>(g_syscallCnt - syscallCnt),
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(SendEvent)->Threads(1)->Threads(4); // 4 threads to send concurrently
+
+static void SendEventContended(benchmark::State& state)
+{
+    RawData data;
+    BuildEvent(data, 3); // 3 is type of behavior event in header
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Transport::GetInstance().SendData(data));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(SendEventContended)->ThreadRange(1, 64)->UseRealTime(); // 1 to 64 threads to write concurrently
+
+static void SendEventInBatch(benchmark::State& state)
+{
+    RawData data;
+    BuildEvent(data, 3); // 3 is type of behavior event in header, which can be staged
+    if (state.thread_index() == 0) {
+        Transport::GetInstance().SetBatchMode(true, static_cast<uint32_t>(state.range(0)),
+            DEFAULT_BATCH_LATENCY_BUDGET);
+    }
+    int64_t syscallCnt = g_syscallCnt;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Transport::GetInstance().SendData(data));
+    }
+    benchmark::DoNotOptimize(Transport::GetInstance().Flush());
+    state.counters["syscalls"] = benchmark::Counter(static_cast<double>(g_syscallCnt - syscallCnt),
+        benchmark::Counter::kAvgIterations);
+    if (state.thread_index() == 0) {
+        Transport::GetInstance().SetBatchMode(false, DEFAULT_BATCH_SIZE, DEFAULT_BATCH_LATENCY_BUDGET);
+    }
+}
+BENCHMARK(SendEventInBatch)->Arg(DEFAULT_BATCH_SIZE)->Arg(MAX_BATCH_SIZE)->Threads(1)->Threads(4); // 4 threads
+
+static void SubmitEventAsync(benchmark::State& state)
+{
+    RawData data;
+    BuildEvent(data, 3); // 3 is type of behavior event in header
+    auto route = EventSocketFactory::GetEventRoute(data);
+    if (state.thread_index() == 0) {
+        AsyncSender::SetEnabled(true, MAX_ASYNC_QUEUE_DEPTH, AsyncDropPolicy::BLOCK);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AsyncSender::Submit(data, route));
+    }
+    if (state.thread_index() == 0) {
+        AsyncSender::SetEnabled(false, MAX_ASYNC_QUEUE_DEPTH, AsyncDropPolicy::BLOCK);
+    }
+}
+BENCHMARK(SubmitEventAsync)->Threads(1)->Threads(4); // 4 threads to submit concurrently
+
+BENCHMARK_MAIN();
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "write_controller.h"
+
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char EVENT_NAME[] = "BENCHMARK";
+constexpr size_t LRU_CACHE_DEFAULT_SIZE = 30;
+constexpr ControlParam PARAM = { HISYSEVENT_DEFAULT_PERIOD, std::numeric_limits<size_t>::max() };
+
+uint64_t GenerateHash(const std::string& info)
+{
+    uint64_t ret { 0xCBF29CE484222325ULL }; // hash basis value
+    for (auto c : info) {
+        ret ^= c;
+        ret *= 0x100000001B3ULL; // hash prime value
+    }
+    return ret;
+}
+
+// the global mutex guarded lru cache used by write controller before, kept here as baseline
+class LegacyEventWroteLruCache {
+public:
+    struct Record {
+        size_t count = 0;
+        uint64_t timestamp = INVALID_TIME_STAMP;
+    };
+
+public:
+    Record Get(uint64_t key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (key2Index_.count(key) == 0) {
+            return Record();
+        }
+        Modify(key);
+        return key2Index_[key].record;
+    }
+
+    void Put(uint64_t key, Record record)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (key2Index_.count(key) > 0) {
+            key2Index_[key].record = record;
+            Modify(key);
+            return;
+        }
+        if (keyCache_.size() == LRU_CACHE_DEFAULT_SIZE) {
+            key2Index_.erase(keyCache_.back());
+            keyCache_.pop_back();
+        }
+        keyCache_.push_front(key);
+        key2Index_[key] = { keyCache_.cbegin(), record };
+    }
+
+private:
+    struct Node {
+        std::list<uint64_t>::const_iterator iter;
+        Record record;
+    };
+
+private:
+    void Modify(uint64_t key)
+    {
+        keyCache_.splice(keyCache_.begin(), keyCache_, key2Index_[key].iter);
+        key2Index_[key].iter = keyCache_.cbegin();
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, Node> key2Index_;
+    std::list<uint64_t> keyCache_;
+};
+
+LegacyEventWroteLruCache g_legacyCache;
+
+uint64_t LegacyCheckLimitWritingEvent(const ControlParam& param, const char* func, int64_t line)
+{
+    std::string info;
+    info.append(EVENT_NAME).append("_").append(func).append("_").append(std::to_string(line));
+    uint64_t key = GenerateHash(info);
+    auto record = g_legacyCache.Get(key);
+    uint64_t cur = WriteController::GetCurrentTimeMills();
+    const uint64_t secToMillis = 1000; // second to millisecond
+    if ((record.count == 0) || ((record.timestamp / secToMillis) + param.period < (cur / secToMillis))) {
+        record = { 1, cur };
+        g_legacyCache.Put(key, record);
+        return cur;
+    }
+    record.count++;
+    g_legacyCache.Put(key, record);
+    return (record.count <= param.threshold) ? cur : INVALID_TIME_STAMP;
+}
+}
+
+static void CheckLimitLegacy(benchmark::State& state)
+{
+    // each thread writes event in its own call site
+    int64_t line = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LegacyCheckLimitWritingEvent(PARAM, __FUNCTION__, line));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckLimitLegacy)->ThreadRange(1, 64)->UseRealTime(); // 1 to 64 threads to write concurrently
+
+static void CheckLimit(benchmark::State& state)
+{
+    // each thread writes event in its own call site
+    int64_t line = state.thread_index();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(WriteController::CheckLimitWritingEvent(PARAM, DOMAIN, EVENT_NAME,
+            __FUNCTION__, line));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(CheckLimit)->ThreadRange(1, 64)->UseRealTime(); // 1 to 64 threads to write concurrently
+
+BENCHMARK_MAIN();
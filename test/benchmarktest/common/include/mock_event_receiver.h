@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_MOCK_EVENT_RECEIVER_H
+#define HISYSEVENT_MOCK_EVENT_RECEIVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace HiviewDFX {
+/*
+ * Stand-in of hiview which receives events from a datagram socket, each event received is decoded, counted and
+ * timestamped, so that events can be written end to end on a device or a host without hiview.
+ */
+class MockEventReceiver {
+public:
+    explicit MockEventReceiver(const std::string& path);
+    ~MockEventReceiver();
+    MockEventReceiver(const MockEventReceiver&) = delete;
+    MockEventReceiver& operator=(const MockEventReceiver&) = delete;
+
+public:
+    // size of receive buffer 0 means the default one of the system
+    bool Start(int recvBufSize = 0);
+    void Stop();
+    void Reset();
+
+    // each event is handled slower by the delay, to make the writers back-pressured
+    void SetHandleDelay(uint32_t delayUs);
+
+    /*
+     * Key of the uint64 parameter which carries the monotonic time in nanoseconds when the event is written,
+     * latency of each event from being written to being received is recorded if the key is set.
+     */
+    void SetSendTimeKey(const std::string& key);
+
+    uint64_t GetReceivedCount() const;
+    uint64_t GetReceivedBytes() const;
+    uint64_t GetMalformedCount() const;
+    std::vector<uint64_t> GetLatencies();
+    bool WaitForCount(uint64_t count, uint32_t timeoutMs) const;
+    const std::string& GetPath() const;
+
+    static uint64_t GetMonotonicTimeNanos();
+
+private:
+    void Receive();
+    void Handle(const uint8_t* data, size_t len, uint64_t recvTime);
+
+private:
+    std::string path_;
+    std::string sendTimeKey_;
+    int socketId_ = -1;
+    std::thread receiver_;
+    std::atomic<bool> isRunning_ { false };
+    std::atomic<uint32_t> handleDelay_ { 0 };
+    std::atomic<uint64_t> receivedCnt_ { 0 };
+    std::atomic<uint64_t> receivedBytes_ { 0 };
+    std::atomic<uint64_t> malformedCnt_ { 0 };
+    std::mutex latenciesMutex_;
+    std::vector<uint64_t> latencies_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+
+#endif // HISYSEVENT_MOCK_EVENT_RECEIVER_H
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mock_event_receiver.h"
+
+#include <cerrno>
+#include <chrono>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "def.h"
+#include "raw_data_decoder.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+constexpr int POLL_TIMEOUT = 50; // 50ms, to check whether the receiver is stopped
+constexpr uint32_t WAIT_INTERVAL = 1; // 1ms
+constexpr size_t RESERVED_LATENCY_CNT = 1024 * 1024;
+}
+
+MockEventReceiver::MockEventReceiver(const std::string& path) : path_(path)
+{
+}
+
+MockEventReceiver::~MockEventReceiver()
+{
+    Stop();
+}
+
+bool MockEventReceiver::Start(int recvBufSize)
+{
+    if (isRunning_) {
+        return true;
+    }
+    struct sockaddr_un addr = { .sun_family = AF_UNIX, .sun_path = { 0 } };
+    if (path_.empty() || strcpy_s(addr.sun_path, sizeof(addr.sun_path), path_.c_str()) != EOK) {
+        return false;
+    }
+    socketId_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (socketId_ < 0) {
+        return false;
+    }
+    if (recvBufSize > 0) {
+        (void)setsockopt(socketId_, SOL_SOCKET, SO_RCVBUF, &recvBufSize, sizeof(recvBufSize));
+    }
+    (void)unlink(path_.c_str());
+    if (bind(socketId_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(socketId_);
+        socketId_ = -1;
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(latenciesMutex_);
+        latencies_.reserve(RESERVED_LATENCY_CNT);
+    }
+    isRunning_ = true;
+    receiver_ = std::thread([this] { Receive(); });
+    return true;
+}
+
+void MockEventReceiver::Stop()
+{
+    if (!isRunning_.exchange(false)) {
+        return;
+    }
+    if (receiver_.joinable()) {
+        receiver_.join();
+    }
+    close(socketId_);
+    socketId_ = -1;
+    (void)unlink(path_.c_str());
+}
+
+void MockEventReceiver::Reset()
+{
+    receivedCnt_ = 0;
+    receivedBytes_ = 0;
+    malformedCnt_ = 0;
+    std::lock_guard<std::mutex> lock(latenciesMutex_);
+    latencies_.clear();
+}
+
+void MockEventReceiver::SetHandleDelay(uint32_t delayUs)
+{
+    handleDelay_ = delayUs;
+}
+
+void MockEventReceiver::SetSendTimeKey(const std::string& key)
+{
+    // the key is read by the receiving thread without lock
+    if (!isRunning_) {
+        sendTimeKey_ = key;
+    }
+}
+
+uint64_t MockEventReceiver::GetReceivedCount() const
+{
+    return receivedCnt_;
+}
+
+uint64_t MockEventReceiver::GetReceivedBytes() const
+{
+    return receivedBytes_;
+}
+
+uint64_t MockEventReceiver::GetMalformedCount() const
+{
+    return malformedCnt_;
+}
+
+std::vector<uint64_t> MockEventReceiver::GetLatencies()
+{
+    std::lock_guard<std::mutex> lock(latenciesMutex_);
+    return latencies_;
+}
+
+bool MockEventReceiver::WaitForCount(uint64_t count, uint32_t timeoutMs) const
+{
+    for (uint32_t waited = 0; receivedCnt_ < count; waited += WAIT_INTERVAL) {
+        if (waited >= timeoutMs) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_INTERVAL));
+    }
+    return true;
+}
+
+const std::string& MockEventReceiver::GetPath() const
+{
+    return path_;
+}
+
+uint64_t MockEventReceiver::GetMonotonicTimeNanos()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void MockEventReceiver::Receive()
+{
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    struct pollfd pollFd = { .fd = socketId_, .events = POLLIN, .revents = 0 };
+    while (isRunning_) {
+        if (poll(&pollFd, 1, POLL_TIMEOUT) <= 0) {
+            continue;
+        }
+        ssize_t len = recv(socketId_, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (len < 0) {
+            continue;
+        }
+        Handle(buffer.data(), static_cast<size_t>(len), GetMonotonicTimeNanos());
+        if (auto delay = handleDelay_.load(std::memory_order_relaxed); delay > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(delay));
+        }
+    }
+}
+
+void MockEventReceiver::Handle(const uint8_t* data, size_t len, uint64_t recvTime)
+{
+    Encoded::RawDataDecoder decoder;
+    Encoded::DecodedParam param;
+    uint64_t sendTime = 0;
+    if (decoder.Init(data, len)) {
+        while (decoder.NextParam(param)) {
+            if (!sendTimeKey_.empty() && param.key == sendTimeKey_ && !param.isArray) {
+                sendTime = param.uint64Value;
+            }
+        }
+    }
+    if (decoder.IsMalformed()) {
+        malformedCnt_++;
+    }
+    receivedBytes_ += len;
+    if (sendTime > 0 && recvTime >= sendTime) {
+        std::lock_guard<std::mutex> lock(latenciesMutex_);
+        latencies_.push_back(recvTime - sendTime);
+    }
+    // latency is recorded before the count is updated, to be seen by the one waiting for the count
+    receivedCnt_++;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "def.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+#include "hisysevent_schema.h"
+#include "raw_data_base_def.h"
+#include "raw_data_decoder.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_aggregation_test_socket";
+constexpr char SCHEMA_EVENT_NAME[] = "AGGREGATION_SCHEMA";
+constexpr char KEY_NAME[] = "NAME";
+constexpr char KEY_COUNT[] = "COUNT";
+using AggregationSchemaEvent = HiSysEventSchema<DOMAIN, SCHEMA_EVENT_NAME, HiSysEvent::EventType::STATISTIC,
+    HiSysEventSchemaKey<KEY_NAME, std::string>, HiSysEventSchemaKey<KEY_COUNT, uint32_t>>;
+}
+
+class HiSysEventAggregationTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventAggregationTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventAggregationTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventAggregationTest::SetUp(void)
+{
+}
+
+void HiSysEventAggregationTest::TearDown(void)
+{
+    HiSysEvent::SetStatisticAggregation(false);
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+}
+
+/**
+ * @tc.name: AggregationTest001
+ * @tc.desc: Statistic events written repeatedly by the same call site are folded into one summary with the sum, min
+ *     and max of numeric parameters, which is sent once the window ends
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAggregationTest, AggregationTest001, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    AggregationStats beginStats;
+    HiSysEvent::GetStatisticAggregationStats(beginStats);
+    HiSysEvent::SetStatisticAggregation(true, MIN_AGGREGATION_WINDOW);
+    const int writeCnt = 5;
+    std::vector<int> rets;
+    for (int i = 1; i <= writeCnt; ++i) {
+        rets.push_back(HiSysEventWrite(DOMAIN, "AGGREGATION", HiSysEvent::EventType::STATISTIC,
+            "NAME", "aggr", "VALUE", i));
+    }
+    AggregationStats endStats;
+    HiSysEvent::GetStatisticAggregationStats(endStats);
+    std::vector<uint8_t> firstEvent(MAX_DATA_SIZE);
+    ssize_t firstLen = recv(socketId, firstEvent.data(), firstEvent.size(), 0);
+    std::vector<uint8_t> summary(MAX_DATA_SIZE);
+    ssize_t summaryLen = recv(socketId, summary.data(), summary.size(), 0);
+    HiSysEvent::SetStatisticAggregation(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(rets, std::vector<int>(writeCnt, SUCCESS));
+    ASSERT_EQ(endStats.sentCnt - beginStats.sentCnt, 1);
+    ASSERT_EQ(endStats.foldedCnt - beginStats.foldedCnt, writeCnt - 1);
+    ASSERT_GT(firstLen, 0);
+    ASSERT_GT(summaryLen, 0);
+
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(summary.data(), static_cast<size_t>(summaryLen)));
+    ASSERT_EQ(decoder.GetName(), "AGGREGATION");
+    std::vector<std::pair<std::string, int64_t>> numericParams;
+    DecodedParam param;
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.stringValue, "aggr");
+    while (decoder.NextParam(param)) {
+        numericParams.emplace_back(std::string(param.key), (param.valueType == ValueType::UINT64) ?
+            static_cast<int64_t>(param.uint64Value) : param.int64Value);
+    }
+    ASSERT_FALSE(decoder.IsMalformed());
+    std::vector<std::pair<std::string, int64_t>> expectedParams = {
+        { "VALUE", 14 }, { "VALUE_MIN", 2 }, { "VALUE_MAX", 5 }, { "AGGR_CNT", 4 } // 2 + 3 + 4 + 5, 2, 5, 4 folded
+    };
+    ASSERT_EQ(numericParams, expectedParams);
+}
+
+/**
+ * @tc.name: AggregationTest002
+ * @tc.desc: Events with different non numeric values are folded into different summaries, and the sum of small
+ *     integers is widened to 64 bits
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAggregationTest, AggregationTest002, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    HiSysEvent::SetStatisticAggregation(true, MIN_AGGREGATION_WINDOW);
+    const int writeCnt = 3;
+    const int8_t value = 100; // the sum of which is out of the range of int8_t
+    const std::vector<std::string> names = { "a", "b" };
+    for (int i = 0; i < writeCnt; ++i) {
+        for (const auto& name : names) {
+            ASSERT_EQ(HiSysEventWrite(DOMAIN, "AGGREGATION", HiSysEvent::EventType::STATISTIC,
+                "NAME", name, "VALUE", value), SUCCESS);
+        }
+    }
+    std::map<std::string, std::pair<uint8_t, int64_t>> summaries;
+    std::vector<uint8_t> data(MAX_DATA_SIZE);
+    ssize_t len = 0;
+    while (summaries.size() < names.size() && (len = recv(socketId, data.data(), data.size(), 0)) > 0) {
+        RawDataDecoder decoder;
+        DecodedParam nameParam;
+        DecodedParam valueParam;
+        DecodedParam foldedCntParam;
+        if (!decoder.Init(data.data(), static_cast<size_t>(len)) || !decoder.NextParam(nameParam) ||
+            !decoder.NextParam(valueParam)) {
+            continue;
+        }
+        // the summary has min, max and the count of events folded besides NAME and VALUE
+        if (decoder.GetParamCount() > 2) { // 2: NAME and VALUE of the event sent at once
+            summaries[std::string(nameParam.stringValue)] = { valueParam.valueType, valueParam.int64Value };
+        }
+    }
+    close(socketId);
+    ASSERT_EQ(summaries.size(), names.size());
+    for (const auto& name : names) {
+        ASSERT_EQ(summaries[name].first, ValueType::INT64);
+        ASSERT_EQ(summaries[name].second, value * (writeCnt - 1));
+    }
+}
+
+/**
+ * @tc.name: AggregationTest003
+ * @tc.desc: Statistic events declared by schema are folded as the ones written with keys, whose numeric
+ *     parameters are summed up
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAggregationTest, AggregationTest003, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    HiSysEvent::SetStatisticAggregation(true, MIN_AGGREGATION_WINDOW);
+    const uint32_t writeCnt = 4;
+    std::vector<int> rets;
+    for (uint32_t i = 1; i <= writeCnt; ++i) {
+        rets.push_back(HiSysEventSchemaWrite(AggregationSchemaEvent, "schema", i));
+    }
+    std::vector<uint8_t> firstEvent(MAX_DATA_SIZE);
+    ssize_t firstLen = recv(socketId, firstEvent.data(), firstEvent.size(), 0);
+    std::vector<uint8_t> summary(MAX_DATA_SIZE);
+    ssize_t summaryLen = recv(socketId, summary.data(), summary.size(), 0);
+    HiSysEvent::SetStatisticAggregation(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(rets, std::vector<int>(writeCnt, SUCCESS));
+    ASSERT_GT(firstLen, 0);
+    ASSERT_GT(summaryLen, 0);
+
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(summary.data(), static_cast<size_t>(summaryLen)));
+    ASSERT_EQ(decoder.GetName(), SCHEMA_EVENT_NAME);
+    DecodedParam param;
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.stringValue, "schema");
+    std::vector<std::pair<std::string, uint64_t>> numericParams;
+    while (decoder.NextParam(param)) {
+        numericParams.emplace_back(std::string(param.key), param.uint64Value);
+    }
+    ASSERT_FALSE(decoder.IsMalformed());
+    std::vector<std::pair<std::string, uint64_t>> expectedParams = {
+        { "COUNT", 9 }, { "COUNT_MIN", 2 }, { "COUNT_MAX", 4 }, { "AGGR_CNT", 3 } // 2 + 3 + 4, 2, 4, 3 folded
+    };
+    ASSERT_EQ(numericParams, expectedParams);
+}
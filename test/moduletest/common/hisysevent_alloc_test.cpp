@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "def.h"
+#include "event_buffer_cache.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_alloc_test_socket";
+
+// allocations are only counted while a test case of this binary is running
+std::atomic<bool> g_isCounting { false };
+std::atomic<size_t> g_allocCnt { 0 };
+
+void* CountedAlloc(size_t size) noexcept
+{
+    if (g_isCounting.load(std::memory_order_relaxed)) {
+        g_allocCnt.fetch_add(1, std::memory_order_relaxed);
+    }
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* CountedAllocOrThrow(size_t size)
+{
+    void* ptr = CountedAlloc(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+size_t GetAllocCnt()
+{
+    return g_allocCnt.load();
+}
+}
+
+// the whole set of replaceable allocation functions is replaced, so that each allocation is freed by the
+// function matching the one which allocates it
+void* operator new(size_t size)
+{
+    return CountedAllocOrThrow(size);
+}
+
+void* operator new[](size_t size)
+{
+    return CountedAllocOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    free(ptr);
+}
+
+class HiSysEventAllocTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventAllocTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventAllocTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventAllocTest::SetUp(void)
+{
+    g_isCounting = true;
+}
+
+void HiSysEventAllocTest::TearDown(void)
+{
+    g_isCounting = false;
+}
+
+/**
+ * @tc.name: EventBufferCacheTest001
+ * @tc.desc: Steady-state writing of event performs no heap allocation with event buffer cached
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAllocTest, EventBufferCacheTest001, TestSize.Level1)
+{
+    EventBufferCache::SetEnabled(true);
+    size_t allocCnt = 0;
+    const int writeTimes = 5; // write 5 times
+    for (int i = 0; i < writeTimes; ++i) {
+        if (i == 1) {
+            allocCnt = GetAllocCnt(); // the first writing is for warming up
+        }
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "EB", HiSysEvent::EventType::BEHAVIOR, "K1", 1, "K2", "VAL"), SUCCESS);
+    }
+    ASSERT_EQ(GetAllocCnt(), allocCnt);
+    EventBufferCache::SetEnabled(false);
+    ASSERT_FALSE(EventBufferCache::IsEnabled());
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "EB", HiSysEvent::EventType::BEHAVIOR, "K1", 1, "K2", "VAL"), SUCCESS);
+    ASSERT_GT(GetAllocCnt(), allocCnt);
+    EventBufferCache::SetEnabled(true);
+}
+
+/**
+ * @tc.name: ArrayParamTest001
+ * @tc.desc: Write array params of std::vector, std::array, C array and std::string_view without allocation
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAllocTest, ArrayParamTest001, TestSize.Level1)
+{
+    EventBufferCache::SetEnabled(true);
+    std::vector<int> intVec = { 1, 2, 3 }; // 1, 2, 3 are test values
+    std::array<uint16_t, 3> uintArr = { 1, 2, 3 }; // 3: size of array, 1, 2, 3 are test values
+    const double doubles[] = { 1.5, 2.5 }; // 1.5, 2.5 are test values
+    const char* strs[] = { "STR1", "STR\n2" };
+    std::vector<std::string_view> views = { "VIEW1", "VIEW2" };
+    size_t allocCnt = 0;
+    const int writeTimes = 5; // write 5 times
+    for (int i = 0; i < writeTimes; ++i) {
+        if (i == 1) {
+            allocCnt = GetAllocCnt(); // the first writing is for warming up
+        }
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "ARRAY", HiSysEvent::EventType::BEHAVIOR, "K1", intVec, "K2", uintArr,
+            "K3", doubles, "K4", strs, "K5", views), SUCCESS);
+    }
+    ASSERT_EQ(GetAllocCnt(), allocCnt);
+}
+
+/**
+ * @tc.name: EventBufferCacheTest002
+ * @tc.desc: Steady-state writing of event larger than 256K performs no heap allocation either, since the cached
+ *     buffer is grown no further than MAX_DATA_SIZE and kept
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventAllocTest, EventBufferCacheTest002, TestSize.Level1)
+{
+    g_isCounting = false;
+    EventBufferCache::SetEnabled(true);
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    // 200K and 60K: the buffer fitting the first value is doubled past MAX_DATA_SIZE by the second one
+    std::string value1(200 * 1024, 'a');
+    std::string value2(60 * 1024, 'b');
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    const int writeTimes = 5; // write 5 times
+    std::vector<int> rets;
+    rets.reserve(writeTimes);
+    g_isCounting = true;
+    size_t allocCnt = 0;
+    for (int i = 0; i < writeTimes; ++i) {
+        if (i == 1) {
+            allocCnt = GetAllocCnt(); // the first writing is for warming up
+        }
+        rets.push_back(HiSysEventWrite(DOMAIN, "LARGE", HiSysEvent::EventType::FAULT, "K1", value1, "K2", value2));
+        // the queue of the socket is drained, so that sending never fails
+        (void)recv(socketId, buffer.data(), buffer.size(), MSG_DONTWAIT);
+    }
+    size_t steadyAllocCnt = GetAllocCnt();
+    g_isCounting = false;
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(rets, std::vector<int>(writeTimes, SUCCESS));
+    ASSERT_EQ(steadyAllocCnt, allocCnt);
+}
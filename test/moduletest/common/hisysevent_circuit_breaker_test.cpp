@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "circuit_breaker.h"
+#include "def.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_circuit_breaker_test_socket";
+}
+
+class HiSysEventCircuitBreakerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventCircuitBreakerTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventCircuitBreakerTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventCircuitBreakerTest::SetUp(void)
+{
+    // each test case starts with the breaker closed
+    HiSysEvent::SetCircuitBreaker(false);
+    HiSysEvent::SetCircuitBreaker(true);
+}
+
+void HiSysEventCircuitBreakerTest::TearDown(void)
+{
+    HiSysEvent::SetCircuitBreaker(true);
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+}
+
+/**
+ * @tc.name: CircuitBreakerTest001
+ * @tc.desc: Events fail fast after sustained failures of sending, and are sent once hiview is available again
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventCircuitBreakerTest, CircuitBreakerTest001, TestSize.Level1)
+{
+    CircuitBreakerStats base;
+    HiSysEvent::GetCircuitBreakerStats(base);
+    ASSERT_EQ(base.state, CircuitState::CLOSED);
+    const uint32_t failureThreshold = 1; // open the breaker once an event fails to send
+    HiSysEvent::SetCircuitBreaker(true, failureThreshold, MIN_CIRCUIT_BACKOFF);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    int failedRet = HiSysEventWrite(DOMAIN, "BREAKER", HiSysEvent::EventType::BEHAVIOR, "KEY", 1);
+    int fastFailedRet = HiSysEventWrite(DOMAIN, "BREAKER", HiSysEvent::EventType::BEHAVIOR, "KEY", 1);
+    CircuitBreakerStats openStats;
+    HiSysEvent::GetCircuitBreakerStats(openStats);
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    const useconds_t recoverTime = 3 * MIN_CIRCUIT_BACKOFF * 1000; // wait for the probe after 3 times of backoff
+    usleep(recoverTime);
+    int recoveredRet = HiSysEventWrite(DOMAIN, "BREAKER", HiSysEvent::EventType::BEHAVIOR, "KEY", 1);
+    CircuitBreakerStats closedStats;
+    HiSysEvent::GetCircuitBreakerStats(closedStats);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    HiSysEvent::SetCircuitBreaker(true);
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(failedRet, ERR_SEND_FAIL);
+    ASSERT_EQ(fastFailedRet, ERR_SEND_FAIL);
+    ASSERT_NE(openStats.state, CircuitState::CLOSED);
+    ASSERT_EQ(openStats.openedCnt, base.openedCnt + 1);
+    ASSERT_GT(openStats.fastFailedCnt, base.fastFailedCnt);
+    ASSERT_EQ(recoveredRet, SUCCESS);
+    ASSERT_EQ(closedStats.state, CircuitState::CLOSED);
+    ASSERT_EQ(closedStats.closedCnt, base.closedCnt + 1);
+    ASSERT_GT(closedStats.probeCnt, base.probeCnt);
+}
+
+/**
+ * @tc.name: CircuitBreakerTest002
+ * @tc.desc: Events are always sent while the breaker is disabled, however many of them fail to send
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventCircuitBreakerTest, CircuitBreakerTest002, TestSize.Level1)
+{
+    CircuitBreakerStats base;
+    HiSysEvent::GetCircuitBreakerStats(base);
+    const uint32_t failureThreshold = 1;
+    HiSysEvent::SetCircuitBreaker(false, failureThreshold, MIN_CIRCUIT_BACKOFF);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    const int failedCnt = 3;
+    for (int i = 0; i < failedCnt; ++i) {
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "BREAKER", HiSysEvent::EventType::BEHAVIOR, "KEY", i), ERR_SEND_FAIL);
+    }
+    CircuitBreakerStats stats;
+    HiSysEvent::GetCircuitBreakerStats(stats);
+    ASSERT_EQ(stats.state, CircuitState::CLOSED);
+    ASSERT_EQ(stats.openedCnt, base.openedCnt);
+    ASSERT_EQ(stats.fastFailedCnt, base.fastFailedCnt);
+}
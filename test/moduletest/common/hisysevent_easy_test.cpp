@@ -15,6 +15,11 @@
 
 #include "hisysevent_easy_test.h"
 
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include "easy_def.h"
 #include "easy_event_builder.h"
 #include "easy_event_encoder.h"
@@ -24,6 +29,27 @@
 
 using namespace testing::ext;
 
+namespace {
+constexpr char LOCAL_SOCKET_PATH[] = "/data/test/hisysevent_easy_test_socket";
+
+// datagram socket which stands in for the one listened by hiview
+int BindLocalSocket(const char* path)
+{
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un addr = { .sun_family = AF_UNIX, .sun_path = { 0 } };
+    struct timeval timeout = { .tv_sec = 1, .tv_usec = 0 };
+    (void)unlink(path);
+    if (socketId < 0 || MemoryCopy(reinterpret_cast<uint8_t*>(addr.sun_path), sizeof(addr.sun_path),
+        reinterpret_cast<uint8_t*>(const_cast<char*>(path)), strlen(path)) != SUCCESS ||
+        bind(socketId, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        setsockopt(socketId, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+        close(socketId);
+        return -1;
+    }
+    return socketId;
+}
+}
+
 void HiSysEventEasyTest::SetUp()
 {}
 
@@ -292,4 +318,30 @@ HWTEST_F(HiSysEventEasyTest, HiSysEventEasyTest012, TestSize.Level3)
     ASSERT_EQ(ret, ERR_MEM_OPT_FAILED);
     ret = MemoryCopy(data, EVENT_BUFF_LEN, dataNew, EVENT_BUFF_LEN);
     ASSERT_EQ(ret, SUCCESS);
-}
\ No newline at end of file
+}
+
+/**
+ * @tc.name: HiSysEventEasyTest013
+ * @tc.desc: Test writing event to the socket whose path is set.
+ * @tc.type: FUNC
+ * @tc.require: issueIAKQGU
+ */
+HWTEST_F(HiSysEventEasyTest, HiSysEventEasyTest013, TestSize.Level3)
+{
+    ASSERT_EQ(HiSysEventEasySetSocketPath(""), ERR_SOCKET_ADDR_INVALID);
+    std::string longPath(sizeof(sockaddr_un::sun_path), 'a');
+    ASSERT_EQ(HiSysEventEasySetSocketPath(longPath.c_str()), ERR_SOCKET_ADDR_INVALID);
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(HiSysEventEasySetSocketPath(LOCAL_SOCKET_PATH), SUCCESS);
+    int ret = OH_HiSysEvent_Easy_Write("KERNEL_VENDOR", "POWER_KEY", EASY_EVENT_TYPE_FAULT, "TEST_DATA");
+    uint8_t buffer[EVENT_BUFF_LEN];
+    ssize_t len = recv(socketId, buffer, sizeof(buffer), 0);
+    ASSERT_EQ(HiSysEventEasySetSocketPath(nullptr), SUCCESS); // null means the default path
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(ret, SUCCESS);
+    ASSERT_GT(len, 0);
+    ret = OH_HiSysEvent_Easy_Write("KERNEL_VENDOR", "POWER_KEY", EASY_EVENT_TYPE_FAULT, "TEST_DATA");
+    ASSERT_EQ(ret, SUCCESS);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,25 +15,127 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <memory>
+#include <random>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 #include "gtest/gtest-message.h"
 #include "gtest/gtest-test-part.h"
 #include "gtest/hwext/gtest-ext.h"
 #include "gtest/hwext/gtest-tag.h"
 
+#include "async_sender.h"
 #include "encoded_param.h"
+#include "event_rule_table.h"
+#include "event_socket_factory.h"
+#include "event_wrote_record_table.h"
 #include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+#include "hisysevent_schema.h"
+#include "process_info_cache.h"
 #include "raw_data_base_def.h"
+#include "raw_data_decoder.h"
 #include "raw_data_encoder.h"
 #include "raw_data.h"
+#include "securec.h"
+#include "stringfilter.h"
 #include "transport.h"
 
 using namespace testing::ext;
 using namespace OHOS::HiviewDFX;
 using namespace OHOS::HiviewDFX::Encoded;
 
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr int CHAR_RANGE = 256;
+constexpr char SCHEMA_EVENT_NAME[] = "SCHEMA_EVENT";
+constexpr char KEY_INT[] = "INT";
+constexpr char KEY_STR[] = "STR";
+constexpr char KEY_LONG[] = "KEY_OF_PARAM_WITH_NAME_LONGER_THAN_THIRTY_TWO";
+constexpr char KEY_ARR[] = "ARR";
+constexpr int VARINT_ROUND = 1000;
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_encoded_test_socket";
+constexpr char PRIORITY_CONFIG_PATH[] = "hisysevent_encoded_test_priority.cfg";
+
+// same transitions as the state machine which checks names char by char
+bool IsValidNameByDfa(const std::string& text, unsigned int maxSize)
+{
+    if (text.empty() || text.length() > maxSize) {
+        return false;
+    }
+    bool isBegin = true;
+    for (auto c : text) {
+        unsigned int ic = static_cast<unsigned char>(c);
+        bool isLetter = (ic >= 'a' && ic <= 'z') || (ic >= 'A' && ic <= 'Z');
+        if (!isLetter && (isBegin || !((ic >= '0' && ic <= '9') || ic == '_'))) {
+            return false;
+        }
+        isBegin = false;
+    }
+    return true;
+}
+
+// same as RawDataEncoder::UnsignedVarintEncoded which encodes the varint byte by byte
+void AppendVarintByteByByte(std::vector<uint8_t>& encoded, uint64_t val)
+{
+    constexpr uint64_t tagByteBound = 0x20;
+    constexpr uint64_t nonTagByteBound = 0x80;
+    constexpr unsigned int tagByteOffset = 5;
+    constexpr unsigned int nonTagByteOffset = 7;
+    encoded.push_back(static_cast<uint8_t>((static_cast<uint8_t>(EncodeType::VARINT) << (tagByteOffset + 1)) |
+        ((val < tagByteBound) ? 0 : tagByteBound) | (val & (tagByteBound - 1))));
+    for (val >>= tagByteOffset; val > 0; val >>= nonTagByteOffset) {
+        encoded.push_back(static_cast<uint8_t>(((val < nonTagByteBound) ? 0 : nonTagByteBound) |
+            (val & (nonTagByteBound - 1))));
+    }
+}
+
+template<typename T>
+bool IsSameAsEncodedByteByByte(const std::vector<T>& values)
+{
+    RawData data;
+    if (!ParamEncoder::ArrayValueEncoded<T>(data, values.begin(), values.size())) {
+        return false;
+    }
+    std::vector<uint8_t> expected;
+    size_t cnt = std::min<size_t>(values.size(), MAX_ARRAY_SIZE);
+    AppendVarintByteByByte(expected, cnt);
+    expected[0] = (expected[0] & 0x3F) | (static_cast<uint8_t>(EncodeType::LENGTH_DELIMITED) << 6); // 6: type bits
+    for (size_t i = 0; i < cnt; ++i) {
+        if constexpr (std::is_unsigned_v<T>) {
+            AppendVarintByteByByte(expected, values[i]);
+        } else {
+            int64_t val = static_cast<int64_t>(values[i]);
+            AppendVarintByteByByte(expected, (static_cast<uint64_t>(val) << 1) ^ ((val < 0) ? UINT64_MAX : 0));
+        }
+    }
+    return data.GetDataLength() == expected.size() &&
+        memcmp(data.GetData(), expected.data(), expected.size()) == 0;
+}
+
+template<typename Key, typename T>
+bool IsSameAsRuntimeEncodedKey(bool isArray)
+{
+    RawData data;
+    if (!RawDataEncoder::StringValueEncoded(data, std::string(Key::KEY)) ||
+        !ParamEncoder::ValueTypeEncoded<T>(data, isArray)) {
+        return false;
+    }
+    return data.GetDataLength() == Key::ENCODED_KEY.size() &&
+        memcmp(data.GetData(), Key::ENCODED_KEY.data(), Key::ENCODED_KEY.size()) == 0;
+}
+}
+
 class HiSysEventEncodedTest : public testing::Test {
 public:
     static void SetUpTestCase(void);
@@ -52,6 +154,9 @@ void HiSysEventEncodedTest::TearDownTestCase(void)
 
 void HiSysEventEncodedTest::SetUp(void)
 {
+    // the breaker may be opened by the flood of events in the former test case
+    HiSysEvent::SetCircuitBreaker(false);
+    HiSysEvent::SetCircuitBreaker(true);
 }
 
 void HiSysEventEncodedTest::TearDown(void)
@@ -80,6 +185,49 @@ HWTEST_F(HiSysEventEncodedTest, EncodeParamTest001, TestSize.Level1)
     ASSERT_GT(data->GetDataLength(), 0);
 }
 
+/**
+ * @tc.name: EncodeParamTest002
+ * @tc.desc: Params encoded by ParamEncoder are the same as the ones encoded by EncodedParam
+ * @tc.type: FUNC
+ * @tc.require: issueI7E737
+ */
+HWTEST_F(HiSysEventEncodedTest, EncodeParamTest002, TestSize.Level1)
+{
+    auto isSameEncoded = [] (std::shared_ptr<EncodedParam> param, const Encoded::RawData& data) {
+        auto rawData = std::make_shared<Encoded::RawData>();
+        param->SetRawData(rawData);
+        return param->Encode() && (rawData->GetDataLength() == data.GetDataLength()) &&
+            (memcmp(rawData->GetData(), data.GetData(), data.GetDataLength()) == 0);
+    };
+    Encoded::RawData data1;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded<uint64_t>(data1, "KEY", std::numeric_limits<uint64_t>::max()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<UnsignedVarintEncodedParam<uint64_t>>("KEY",
+        std::numeric_limits<uint64_t>::max()), data1));
+    Encoded::RawData data2;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded<int16_t>(data2, "KEY", std::numeric_limits<int16_t>::min()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<SignedVarintEncodedParam<int16_t>>("KEY",
+        std::numeric_limits<int16_t>::min()), data2));
+    Encoded::RawData data3;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded<double>(data3, "KEY", std::numeric_limits<double>::infinity()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<FloatingNumberEncodedParam<double>>("KEY",
+        std::numeric_limits<double>::infinity()), data3));
+    Encoded::RawData data4;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded<std::string>(data4, "KEY", std::string("VALUE")));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<StringEncodedParam>("KEY", "VALUE"), data4));
+    std::vector<int32_t> vals(MAX_ARRAY_SIZE + 1, -1); // 1 more item than the maximum size of array
+    Encoded::RawData data5;
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<int32_t>(data5, "KEY", vals.begin(), vals.size()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<SignedVarintEncodedArrayParam<int32_t>>("KEY", vals), data5));
+    std::vector<float> floatVals = { 1.0, std::numeric_limits<float>::quiet_NaN() };
+    Encoded::RawData data6;
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<float>(data6, "KEY", floatVals.begin(), floatVals.size()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<FloatingNumberEncodedArrayParam<float>>("KEY", floatVals), data6));
+    std::vector<std::string> strVals = { "VALUE1", "VALUE2" };
+    Encoded::RawData data7;
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<std::string>(data7, "KEY", strVals.begin(), strVals.size()));
+    ASSERT_TRUE(isSameEncoded(std::make_shared<StringEncodedArrayParam>("KEY", strVals), data7));
+}
+
 /**
  * @tc.name: RawDatabaseDefTest001
  * @tc.desc: Some api interfaces of raw data base definition test
@@ -115,6 +263,42 @@ HWTEST_F(HiSysEventEncodedTest, RawDataTest001, TestSize.Level1)
     ASSERT_EQ(rawData1.GetDataLength(), rawData4.GetDataLength());
 }
 
+/**
+ * @tc.name: RawDataTest002
+ * @tc.desc: Reserve, expansion and move semantics of RawData
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, RawDataTest002, TestSize.Level1)
+{
+    Encoded::RawData rawData1;
+    ASSERT_TRUE(rawData1.Reserve(MAX_DATA_SIZE));
+    ASSERT_EQ(rawData1.GetCapacity(), MAX_DATA_SIZE);
+    auto reservedBuf = rawData1.GetData();
+    uint8_t unit[64] = { 0 }; // 64 is a random test size
+    size_t unitCnt = MAX_DATA_SIZE / sizeof(unit);
+    for (size_t i = 0; i < unitCnt; ++i) {
+        ASSERT_TRUE(rawData1.Append(unit, sizeof(unit)));
+    }
+    ASSERT_EQ(rawData1.GetData(), reservedBuf); // no reallocation with enough capacity reserved
+    ASSERT_TRUE(rawData1.Append(unit, sizeof(unit)));
+    ASSERT_GE(rawData1.GetCapacity(), MAX_DATA_SIZE * 2); // 2: growth factor
+    ASSERT_TRUE(rawData1.Reserve(1)); // reserve less than capacity is no-op
+    size_t dataLen = rawData1.GetDataLength();
+    ASSERT_EQ(dataLen, (unitCnt + 1) * sizeof(unit));
+
+    auto buf = rawData1.GetData();
+    Encoded::RawData rawData2(std::move(rawData1));
+    ASSERT_EQ(rawData2.GetData(), buf);
+    ASSERT_EQ(rawData2.GetDataLength(), dataLen);
+    ASSERT_TRUE(rawData1.IsEmpty());
+    Encoded::RawData rawData3;
+    rawData3 = std::move(rawData2);
+    ASSERT_EQ(rawData3.GetData(), buf);
+    ASSERT_EQ(rawData3.GetDataLength(), dataLen);
+    ASSERT_TRUE(rawData2.IsEmpty());
+}
+
 /**
  * @tc.name: TransportTest001
  * @tc.desc: Send raw data
@@ -135,3 +319,759 @@ HWTEST_F(HiSysEventEncodedTest, TransportTest001, TestSize.Level1)
     ASSERT_TRUE(!rawData2->IsEmpty());
     ASSERT_EQ(Transport::GetInstance().SendData(*rawData2), SUCCESS);
 }
+
+/**
+ * @tc.name: TransportTest002
+ * @tc.desc: Send raw data with the per-thread socket after fork
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, TransportTest002, TestSize.Level1)
+{
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "TRANSPORT", HiSysEvent::EventType::BEHAVIOR, "K1", 1), SUCCESS);
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // socket inherited from the parent should be reopened in the child process
+        int ret = HiSysEventWrite(DOMAIN, "TRANSPORT", HiSysEvent::EventType::BEHAVIOR, "K1", 2); // 2 is a test value
+        _exit(ret == SUCCESS ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    // 3 is a test value
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "TRANSPORT", HiSysEvent::EventType::BEHAVIOR, "K1", 3), SUCCESS);
+}
+
+/**
+ * @tc.name: TransportBatchTest001
+ * @tc.desc: Write events in batch mode and flush the staged events
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, TransportBatchTest001, TestSize.Level1)
+{
+    const uint32_t batchSize = 4; // 4 events in one batch
+    const uint32_t latencyBudget = 1000; // 1000ms
+    HiSysEvent::SetBatchMode(true, batchSize, latencyBudget);
+    for (uint32_t i = 0; i < batchSize + 1; ++i) {
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "BATCH", HiSysEvent::EventType::STATISTIC, "K1", i), SUCCESS);
+    }
+    // events of FAULT type are never staged
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "BATCH", HiSysEvent::EventType::FAULT, "K1", 1), SUCCESS);
+    ASSERT_EQ(HiSysEvent::Flush(), SUCCESS);
+    ASSERT_EQ(HiSysEvent::Flush(), SUCCESS);
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "BATCH", HiSysEvent::EventType::STATISTIC, "K1", 1), SUCCESS);
+    HiSysEvent::SetBatchMode(false);
+    ASSERT_EQ(HiSysEvent::Flush(), SUCCESS);
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "BATCH", HiSysEvent::EventType::STATISTIC, "K1", 1), SUCCESS);
+}
+
+/**
+ * @tc.name: TransportBatchTest002
+ * @tc.desc: Events staged by the thread which writes no more events are sent in background once the latency
+ *     budget is used up
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, TransportBatchTest002, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    const uint32_t batchSize = 4; // 4 events in one batch
+    const uint32_t latencyBudget = 50; // 50ms
+    HiSysEvent::SetBatchMode(true, batchSize, latencyBudget);
+    const int64_t writeCnt = batchSize - 1;
+    std::vector<int> rets;
+    for (int64_t i = 0; i < writeCnt; ++i) {
+        rets.push_back(HiSysEventWrite(DOMAIN, "BATCH_BUDGET", HiSysEvent::EventType::STATISTIC, "KEY", i));
+    }
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    ssize_t stagedLen = recv(socketId, buffer.data(), buffer.size(), MSG_DONTWAIT);
+    std::vector<int64_t> receivedKeys;
+    ssize_t len = 0;
+    // the receiving times out after 1s, much longer than the budget
+    while (receivedKeys.size() < static_cast<size_t>(writeCnt) &&
+        (len = recv(socketId, buffer.data(), buffer.size(), 0)) > 0) {
+        RawDataDecoder decoder;
+        DecodedParam param;
+        if (!decoder.Init(buffer.data(), static_cast<size_t>(len)) || decoder.GetName() != "BATCH_BUDGET") {
+            continue;
+        }
+        while (decoder.NextParam(param)) {
+            if (param.key == "KEY") {
+                receivedKeys.push_back(param.int64Value);
+            }
+        }
+    }
+    HiSysEvent::SetBatchMode(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(rets, std::vector<int>(writeCnt, SUCCESS));
+    ASSERT_LT(stagedLen, 0); // nothing is sent before the budget is used up
+    ASSERT_EQ(receivedKeys, std::vector<int64_t>({ 0, 1, 2 })); // 0, 1, 2: keys of the events staged
+}
+
+/**
+ * @tc.name: TransportRetryTest001
+ * @tc.desc: Events failed to send are retried in background once hiview is available, and the oldest ones are
+ *     dropped if more than RETRY_QUEUE_SIZE events are waiting
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, TransportRetryTest001, TestSize.Level1)
+{
+    HiSysEvent::SetCircuitBreaker(false);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    const int droppedCnt = 3;
+    const int failedCnt = static_cast<int>(Transport::RETRY_QUEUE_SIZE) + droppedCnt;
+    std::vector<int> failedRets;
+    for (int i = 0; i < failedCnt; ++i) {
+        failedRets.push_back(HiSysEventWrite(DOMAIN, "RETRY", HiSysEvent::EventType::BEHAVIOR, "KEY", i));
+    }
+    usleep(100000); // 100ms, wait for the retry thread to take all failed events and fail to send them
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    // the event written successfully wakes up the retry thread
+    int succeededRet = HiSysEventWrite(DOMAIN, "RETRY", HiSysEvent::EventType::BEHAVIOR, "KEY", failedCnt);
+    std::vector<int64_t> receivedKeys;
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    ssize_t len = 0;
+    // the receiving times out after 1s once all retried events are received
+    while (socketId >= 0 && (len = recv(socketId, buffer.data(), buffer.size(), 0)) > 0) {
+        RawDataDecoder decoder;
+        DecodedParam param;
+        // events failed in the former test cases may be retried too
+        if (!decoder.Init(buffer.data(), static_cast<size_t>(len)) || decoder.GetName() != "RETRY") {
+            continue;
+        }
+        while (decoder.NextParam(param)) {
+            if (param.key == "KEY") {
+                receivedKeys.push_back(param.int64Value);
+            }
+        }
+    }
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    HiSysEvent::SetCircuitBreaker(true);
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_EQ(failedRets, std::vector<int>(failedCnt, ERR_SEND_FAIL));
+    ASSERT_EQ(succeededRet, SUCCESS);
+    std::vector<int64_t> expectedKeys = { failedCnt };
+    for (int i = droppedCnt; i < failedCnt; ++i) {
+        expectedKeys.push_back(i);
+    }
+    ASSERT_EQ(receivedKeys, expectedKeys);
+}
+
+/**
+ * @tc.name: AsyncSenderTest001
+ * @tc.desc: Write events in async mode with validation result returned synchronously
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, AsyncSenderTest001, TestSize.Level1)
+{
+    const uint32_t queueDepth = 8; // 8 events at most in queue
+    HiSysEvent::SetAsyncMode(true, queueDepth, AsyncDropPolicy::DROP_OLDEST);
+    ASSERT_TRUE(AsyncSender::IsEnabled());
+    for (uint32_t i = 0; i < queueDepth * 2; ++i) { // 2 times of queue depth
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "ASYNC", HiSysEvent::EventType::BEHAVIOR, "K1", i), SUCCESS);
+    }
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "123ASYNC", HiSysEvent::EventType::BEHAVIOR, "K1", 1), ERR_EVENT_NAME_INVALID);
+    HiSysEvent::SetAsyncMode(true, queueDepth, AsyncDropPolicy::BLOCK);
+    for (uint32_t i = 0; i < queueDepth * 2; ++i) { // 2 times of queue depth
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "ASYNC", HiSysEvent::EventType::BEHAVIOR, "K1", i), SUCCESS);
+    }
+    uint64_t droppedCnt = HiSysEvent::GetAsyncDroppedCount();
+    HiSysEvent::SetAsyncMode(false);
+    ASSERT_FALSE(AsyncSender::IsEnabled());
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "ASYNC", HiSysEvent::EventType::BEHAVIOR, "K1", 1), SUCCESS);
+    ASSERT_EQ(HiSysEvent::GetAsyncDroppedCount(), droppedCnt);
+}
+
+/**
+ * @tc.name: AsyncSenderTest002
+ * @tc.desc: Write events in async mode by lanes with separate queues and counters
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, AsyncSenderTest002, TestSize.Level1)
+{
+    ASSERT_FALSE(HiSysEvent::SetAsyncPriorityLanes({}));
+    ASSERT_FALSE(HiSysEvent::SetAsyncPriorityLanes(std::vector<PriorityLaneConfig>(MAX_PRIORITY_LANE_CNT + 1)));
+    ASSERT_FALSE(HiSysEvent::SetAsyncPriorityLanes({ { 8, AsyncDropPolicy::DROP_NEWEST, { "123 * FAULT" } } }));
+    const uint32_t queueDepth = 8; // 8 events at most in queue
+    std::vector<PriorityLaneConfig> lanes = {
+        { queueDepth, AsyncDropPolicy::BLOCK, { std::string(DOMAIN) + " * FAULT" } },
+        { queueDepth, AsyncDropPolicy::DROP_NEWEST, {} },
+    };
+    ASSERT_TRUE(HiSysEvent::SetAsyncPriorityLanes(lanes));
+    ASSERT_TRUE(AsyncSender::IsEnabled());
+    ASSERT_EQ(AsyncSender::GetPriorityLaneCount(), lanes.size());
+    PriorityLaneStats faultStats;
+    PriorityLaneStats otherStats;
+    ASSERT_TRUE(HiSysEvent::GetAsyncPriorityLaneStats(0, faultStats));
+    ASSERT_TRUE(HiSysEvent::GetAsyncPriorityLaneStats(1, otherStats));
+    ASSERT_FALSE(HiSysEvent::GetAsyncPriorityLaneStats(MAX_PRIORITY_LANE_CNT, otherStats));
+    const uint64_t eventCnt = queueDepth * 4; // 4 times of queue depth
+    for (uint64_t i = 0; i < eventCnt; ++i) {
+        ASSERT_EQ(HiSysEventWrite(DOMAIN, "LANE", HiSysEvent::EventType::FAULT, "K1", i), SUCCESS);
+        (void)HiSysEventWrite(DOMAIN, "LANE", HiSysEvent::EventType::STATISTIC, "K1", i);
+    }
+    auto getHandledCnt = [] (uint32_t lane, const PriorityLaneStats& base, PriorityLaneStats& stats) {
+        (void)HiSysEvent::GetAsyncPriorityLaneStats(lane, stats);
+        return stats.sentCnt + stats.failedCnt + stats.droppedCnt - base.sentCnt - base.failedCnt -
+            base.droppedCnt;
+    };
+    const int maxWaitTimes = 3000; // 3s at most to wait for the lanes to send events
+    PriorityLaneStats stats;
+    for (int i = 0; i < maxWaitTimes && (getHandledCnt(0, faultStats, stats) < eventCnt ||
+        getHandledCnt(1, otherStats, stats) < eventCnt); ++i) {
+        usleep(1000); // 1ms
+    }
+    HiSysEvent::SetAsyncMode(false);
+    // events queued by the former tests may be sent by the first lane as well
+    ASSERT_GE(getHandledCnt(0, faultStats, stats), eventCnt);
+    ASSERT_EQ(stats.droppedCnt, faultStats.droppedCnt);
+    ASSERT_GT(stats.queueHighWaterMark, 0U);
+    ASSERT_LE(stats.queueHighWaterMark, queueDepth);
+    ASSERT_EQ(getHandledCnt(1, otherStats, stats), eventCnt);
+    ASSERT_LE(stats.queueHighWaterMark, queueDepth);
+}
+
+/**
+ * @tc.name: WriteControllerTest001
+ * @tc.desc: Limit writing event by the record of call site
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, WriteControllerTest001, TestSize.Level1)
+{
+    const ControlParam param = { HISYSEVENT_DEFAULT_PERIOD, 2 }; // 2 events at most during one period
+    CallSiteRecord record { 0 };
+    CallSiteRecord otherRecord { 0 };
+    ASSERT_NE(WriteController::CheckLimitWritingEvent(param, DOMAIN, "LIMIT", __FUNCTION__, record),
+        INVALID_TIME_STAMP);
+    ASSERT_NE(WriteController::CheckLimitWritingEvent(param, DOMAIN, "LIMIT", __FUNCTION__, record),
+        INVALID_TIME_STAMP);
+    ASSERT_EQ(WriteController::CheckLimitWritingEvent(param, DOMAIN, "LIMIT", __FUNCTION__, record),
+        INVALID_TIME_STAMP);
+    ASSERT_NE(WriteController::CheckLimitWritingEvent(param, DOMAIN, "LIMIT", __FUNCTION__, otherRecord),
+        INVALID_TIME_STAMP);
+    std::string eventName = "LIMIT";
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "LIMIT", HiSysEvent::EventType::BEHAVIOR, "K1", 1), SUCCESS);
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, eventName, HiSysEvent::EventType::BEHAVIOR, "K1", 1), SUCCESS);
+}
+
+/**
+ * @tc.name: WriteControllerTest002
+ * @tc.desc: Records of call sites are inserted and found by keys, and the oldest record in the probe window is
+ *     reused once all slots of the window are taken by colliding keys
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, WriteControllerTest002, TestSize.Level1)
+{
+    auto table = std::make_unique<EventWroteRecordTable>();
+    const uint64_t key = 0x1234;
+    CallSiteRecord& record = table->GetRecord(key);
+    record.store(1);
+    ASSERT_EQ(&table->GetRecord(key), &record);
+    ASSERT_EQ(table->GetRecord(key).load(), 1);
+    ASSERT_NE(&table->GetRecord(key + 1), &record);
+    ASSERT_EQ(&table->GetRecord(0), &table->GetRecord(1)); // 0 is reserved for the empty slot
+
+    // keys with the same lower bits are placed into the same probe window
+    const uint64_t collidedKey = 0x5680; // the probe window is apart from the slots taken above
+    std::vector<CallSiteRecord*> collidedRecords;
+    for (size_t i = 0; i < EventWroteRecordTable::PROBE_LIMIT; ++i) {
+        collidedRecords.push_back(&table->GetRecord(collidedKey + i * EventWroteRecordTable::TABLE_SIZE));
+        // the record of the first key is never updated, which is the oldest one
+        collidedRecords.back()->store((i == 0) ? 0 : std::numeric_limits<uint64_t>::max());
+    }
+    for (size_t i = 0; i < EventWroteRecordTable::PROBE_LIMIT; ++i) {
+        ASSERT_EQ(&table->GetRecord(collidedKey + i * EventWroteRecordTable::TABLE_SIZE), collidedRecords[i]);
+    }
+    std::sort(collidedRecords.begin(), collidedRecords.end());
+    ASSERT_EQ(std::unique(collidedRecords.begin(), collidedRecords.end()), collidedRecords.end());
+    collidedRecords.front()->store(0);
+    CallSiteRecord& reusedRecord = table->GetRecord(collidedKey +
+        EventWroteRecordTable::PROBE_LIMIT * EventWroteRecordTable::TABLE_SIZE);
+    ASSERT_EQ(&reusedRecord, &table->GetRecord(collidedKey +
+        EventWroteRecordTable::PROBE_LIMIT * EventWroteRecordTable::TABLE_SIZE));
+    ASSERT_EQ(reusedRecord.load(), 0);
+    for (size_t i = 1; i < EventWroteRecordTable::PROBE_LIMIT; ++i) {
+        ASSERT_EQ(table->GetRecord(collidedKey + i * EventWroteRecordTable::TABLE_SIZE).load(),
+            std::numeric_limits<uint64_t>::max());
+    }
+}
+
+/**
+ * @tc.name: WriteControllerTest003
+ * @tc.desc: Records of call sites are found and updated by threads concurrently, no update is lost
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, WriteControllerTest003, TestSize.Level1)
+{
+    auto table = std::make_unique<EventWroteRecordTable>();
+    const size_t threadCnt = 8;
+    const size_t keyCnt = 64; // fewer than the slots, so that no record is reused
+    const uint64_t updateCnt = 1000;
+    std::atomic<bool> isStarted { false };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&table, &isStarted, i] {
+            while (!isStarted.load()) {}
+            for (uint64_t round = 0; round < updateCnt; ++round) {
+                // each thread begins with different keys, which are inserted while the others are updated
+                for (size_t j = 0; j < keyCnt; ++j) {
+                    (void)table->GetRecord(((i + j) % keyCnt) + 1).fetch_add(1);
+                }
+            }
+        });
+    }
+    isStarted.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t j = 0; j < keyCnt; ++j) {
+        ASSERT_EQ(table->GetRecord(j + 1).load(), threadCnt * updateCnt);
+    }
+}
+
+/**
+ * @tc.name: ProcessInfoCacheTest001
+ * @tc.desc: Cached pid and tid are refreshed in the child process after fork
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, ProcessInfoCacheTest001, TestSize.Level1)
+{
+    ASSERT_EQ(ProcessInfoCache::GetPid(), static_cast<uint32_t>(getprocpid()));
+    ASSERT_EQ(ProcessInfoCache::GetTid(), static_cast<uint32_t>(getproctid()));
+    ASSERT_EQ(ProcessInfoCache::GetTimeZoneIndex(), static_cast<uint8_t>(ParseTimeZone(timezone)));
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        bool isRefreshed = (ProcessInfoCache::GetPid() == static_cast<uint32_t>(getprocpid())) &&
+            (ProcessInfoCache::GetTid() == static_cast<uint32_t>(getproctid()));
+        _exit(isRefreshed ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+}
+
+/**
+ * @tc.name: StringFilterTest001
+ * @tc.desc: Escape strings with chars to escape inside and across the scanned blocks
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, StringFilterTest001, TestSize.Level1)
+{
+    auto& filter = StringFilter::GetInstance();
+    ASSERT_EQ(filter.EscapeToRaw(""), "");
+    ASSERT_EQ(filter.EscapeToRaw("a\"b\\c\td\x01" "e\x7F"), "a\\\"b\\\\c\\tde");
+    std::string text(40, 'a'); // 40: cross the blocks of 16 bytes
+    text[15] = '\n'; // 15: the last char of the first block
+    text[16] = '\x02'; // 16: the first char of the second block
+    text[39] = '\\'; // 39: the last char of the tail
+    std::string expected = std::string(15, 'a') + "\\n" + std::string(22, 'a') + "\\\\"; // 15, 22: count of 'a'
+    ASSERT_EQ(filter.EscapeToRaw(text), expected);
+    ASSERT_EQ(filter.GetEscapedLength(text.c_str(), text.length()), expected.length());
+
+    RawData escapedInPlace;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded(escapedInPlace, "KEY", EscapedString { text.c_str(), text.length() }));
+    RawData escapedByCopy;
+    ASSERT_TRUE(ParamEncoder::ParamEncoded(escapedByCopy, "KEY", expected));
+    ASSERT_EQ(escapedInPlace.GetDataLength(), escapedByCopy.GetDataLength());
+    ASSERT_EQ(memcmp(escapedInPlace.GetData(), escapedByCopy.GetData(), escapedByCopy.GetDataLength()), 0);
+}
+
+/**
+ * @tc.name: StringFilterTest002
+ * @tc.desc: Check names with each byte value at each position, same as the state machine
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, StringFilterTest002, TestSize.Level1)
+{
+    auto& filter = StringFilter::GetInstance();
+    for (size_t len = 1; len <= MAX_PARAM_NAME_LENGTH + 1; ++len) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (int c = 0; c < CHAR_RANGE; ++c) {
+                std::string name(len, 'a');
+                name[pos] = static_cast<char>(c);
+                bool isValid = IsValidNameByDfa(name, MAX_PARAM_NAME_LENGTH);
+                ASSERT_EQ(filter.IsValidName(name, MAX_PARAM_NAME_LENGTH), isValid) << "char=" << c << ", pos=" << pos;
+                ASSERT_EQ(StringFilter::IsValidConstName(name, MAX_PARAM_NAME_LENGTH), isValid);
+            }
+        }
+    }
+    static_assert(StringFilter::IsValidConstName(DOMAIN, MAX_DOMAIN_LENGTH));
+    static_assert(!StringFilter::IsValidConstName("1DOMAIN", MAX_DOMAIN_LENGTH));
+    static_assert(!StringFilter::IsValidConstName("DOMAIN_NAME_TOO_LONG", MAX_DOMAIN_LENGTH));
+}
+
+/**
+ * @tc.name: SchemaTest001
+ * @tc.desc: Keys of event schema encoded at compile time are same as the keys encoded while writing, and
+ *     events of schema are aggregated by each call site
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, SchemaTest001, TestSize.Level1)
+{
+    using IntKey = HiSysEventSchemaKey<KEY_INT, int32_t>;
+    using StrKey = HiSysEventSchemaKey<KEY_STR, std::string>;
+    using LongKey = HiSysEventSchemaKey<KEY_LONG, uint64_t>;
+    using ArrKey = HiSysEventSchemaKey<KEY_ARR, std::vector<double>>;
+    ASSERT_TRUE((IsSameAsRuntimeEncodedKey<IntKey, int32_t>(false)));
+    ASSERT_TRUE((IsSameAsRuntimeEncodedKey<StrKey, std::string>(false)));
+    ASSERT_TRUE((IsSameAsRuntimeEncodedKey<LongKey, uint64_t>(false)));
+    ASSERT_TRUE((IsSameAsRuntimeEncodedKey<ArrKey, double>(true)));
+
+    using SchemaEvent = HiSysEventSchema<DOMAIN, SCHEMA_EVENT_NAME, HiSysEvent::EventType::BEHAVIOR,
+        IntKey, StrKey, LongKey, ArrKey>;
+    std::vector<double> values = { 1.0, 2.0 };
+    ASSERT_EQ(HiSysEventSchemaWrite(SchemaEvent, 1, "schema", 2U, values), SUCCESS); // 2: a test value
+
+    // events are folded by each call site, same as the ones written by HiSysEventWrite
+    using StatisticEvent = HiSysEventSchema<DOMAIN, SCHEMA_EVENT_NAME, HiSysEvent::EventType::STATISTIC, IntKey>;
+    AggregationStats beginStats;
+    HiSysEvent::GetStatisticAggregationStats(beginStats);
+    HiSysEvent::SetStatisticAggregation(true, MIN_AGGREGATION_WINDOW);
+    const int writeCnt = 3;
+    std::vector<int> rets;
+    for (int i = 0; i < writeCnt; ++i) {
+        rets.push_back(HiSysEventSchemaWrite(StatisticEvent, i));
+        rets.push_back(HiSysEventSchemaWrite(StatisticEvent, i));
+    }
+    AggregationStats endStats;
+    HiSysEvent::GetStatisticAggregationStats(endStats);
+    HiSysEvent::SetStatisticAggregation(false);
+    ASSERT_EQ(rets, std::vector<int>(2 * writeCnt, SUCCESS)); // 2: events of both call sites
+    ASSERT_EQ(endStats.sentCnt - beginStats.sentCnt, 2); // 2: the first event of each call site
+    ASSERT_EQ(endStats.foldedCnt - beginStats.foldedCnt, 2 * (writeCnt - 1)); // 2: events of both call sites
+}
+
+/**
+ * @tc.name: VarintArrayTest001
+ * @tc.desc: Encode arrays of integers together, same as encoding the varints byte by byte
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, VarintArrayTest001, TestSize.Level1)
+{
+    std::vector<uint64_t> bounds;
+    for (unsigned int bit = 0; bit < 64; ++bit) { // 64: bits of uint64_t
+        bounds.push_back((1ULL << bit) - 1);
+        bounds.push_back(1ULL << bit);
+    }
+    bounds.push_back(UINT64_MAX);
+    ASSERT_TRUE(IsSameAsEncodedByteByByte(bounds));
+    std::vector<int64_t> signedBounds;
+    for (auto bound : bounds) {
+        signedBounds.push_back(static_cast<int64_t>(bound));
+        signedBounds.push_back(static_cast<int64_t>(0 - bound)); // negated as unsigned, which never overflows
+    }
+    signedBounds.push_back(INT64_MIN);
+    signedBounds.push_back(INT64_MIN + 1);
+    ASSERT_TRUE(IsSameAsEncodedByteByByte(signedBounds));
+
+    std::mt19937_64 engine(VARINT_ROUND);
+    for (int round = 0; round < VARINT_ROUND; ++round) {
+        std::vector<uint64_t> values(engine() % (MAX_ARRAY_SIZE + 2)); // 2: cover arrays to be truncated
+        for (auto& val : values) {
+            val = engine() >> (engine() % 64); // 64: values of random bit count
+        }
+        ASSERT_TRUE(IsSameAsEncodedByteByByte(values));
+        std::vector<int64_t> signedValues(values.begin(), values.end());
+        ASSERT_TRUE(IsSameAsEncodedByteByByte(signedValues));
+        std::vector<int16_t> shortValues(values.begin(), values.end());
+        ASSERT_TRUE(IsSameAsEncodedByteByByte(shortValues));
+        std::vector<uint8_t> byteValues(values.begin(), values.end());
+        ASSERT_TRUE(IsSameAsEncodedByteByByte(byteValues));
+    }
+}
+
+/**
+ * @tc.name: PackedArrayTest001
+ * @tc.desc: Items of float and double arrays are packed as fixed width values following the count of items
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, PackedArrayTest001, TestSize.Level1)
+{
+    HiSysEvent::SetPackedArrayMode(true);
+    // 1 more item than the maximum size of array, 1.5 is a test value
+    std::vector<double> vals(MAX_ARRAY_SIZE + 1, 1.5);
+    vals[1] = std::numeric_limits<double>::infinity();
+    RawData data;
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<double>(data, "KEY", vals.begin(), vals.size()));
+    RawData expected;
+    ASSERT_TRUE(RawDataEncoder::StringValueEncoded(expected, "KEY"));
+    ASSERT_TRUE(RawDataEncoder::ValueTypeEncoded(expected, true, ValueType::DOUBLE, PACKED_DOUBLE_BYTE_CNT));
+    ASSERT_TRUE(RawDataEncoder::UnsignedVarintEncoded(expected, EncodeType::LENGTH_DELIMITED,
+        static_cast<size_t>(MAX_ARRAY_SIZE)));
+    for (size_t i = 0; i < MAX_ARRAY_SIZE; ++i) {
+        double item = (i == 1) ? 0.0 : vals[i]; // item which is not finite is encoded as 0
+        ASSERT_TRUE(expected.Append(reinterpret_cast<uint8_t*>(&item), sizeof(item)));
+    }
+    ASSERT_EQ(data.GetDataLength(), expected.GetDataLength());
+    ASSERT_EQ(memcmp(data.GetData(), expected.GetData(), expected.GetDataLength()), 0);
+
+    std::vector<float> floatVals = { 1.0, 2.0 }; // 1.0, 2.0 are test values
+    RawData floatData;
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<float>(floatData, "KEY", floatVals.begin(), floatVals.size()));
+    auto param = std::make_shared<FloatingNumberEncodedArrayParam<float>>("KEY", floatVals);
+    auto rawData = std::make_shared<RawData>();
+    param->SetRawData(rawData);
+    ASSERT_TRUE(param->Encode());
+    ASSERT_EQ(rawData->GetDataLength(), floatData.GetDataLength());
+    ASSERT_EQ(memcmp(rawData->GetData(), floatData.GetData(), floatData.GetDataLength()), 0);
+    HiSysEvent::SetPackedArrayMode(false);
+    vals.resize(MAX_ARRAY_SIZE);
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "PACKED", HiSysEvent::EventType::BEHAVIOR, "K1", vals), SUCCESS);
+}
+
+/**
+ * @tc.name: DecoderTest001
+ * @tc.desc: Parameters of event encoded are decoded by the reference decoder, and malformed event is rejected
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, DecoderTest001, TestSize.Level1)
+{
+    RawData data;
+    HiSysEventHeader header = { "DOMAIN", "EVENT_NAME", 0, 0, 0, 0, 0, 0, 1, 1 }; // 1: FAULT, 1: with trace info
+    TraceInfo traceInfo = { 1, 2, 3, 4 }; // 1, 2, 3, 4: test trace info
+    int32_t blockSize = 0;
+    int32_t paramCnt = 5; // 5: count of parameters below
+    ASSERT_TRUE(data.Append(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t)));
+    ASSERT_TRUE(data.Append(reinterpret_cast<uint8_t*>(&header), sizeof(struct HiSysEventHeader)));
+    ASSERT_TRUE(data.Append(reinterpret_cast<uint8_t*>(&traceInfo), sizeof(struct TraceInfo)));
+    ASSERT_TRUE(data.Append(reinterpret_cast<uint8_t*>(&paramCnt), sizeof(int32_t)));
+    ASSERT_TRUE(ParamEncoder::ParamEncoded(data, "INT", INT64_MIN));
+    ASSERT_TRUE(ParamEncoder::ParamEncoded(data, "UINT", UINT64_MAX));
+    ASSERT_TRUE(ParamEncoder::ParamEncoded(data, "STR", EscapedString { "a\nb", 3 })); // 3: length of "a\nb"
+    std::vector<std::string> strs = { "", "abc" };
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<std::string>(data, "STRS", strs.begin(), strs.size()));
+    RawDataEncoder::SetPackedArrayEnabled(true);
+    std::vector<float> floats = { 1.5, -2.0 }; // 1.5, -2.0: test values
+    ASSERT_TRUE(ParamEncoder::ArrayParamEncoded<float>(data, "FLOATS", floats.begin(), floats.size()));
+    RawDataEncoder::SetPackedArrayEnabled(false);
+    blockSize = static_cast<int32_t>(data.GetDataLength());
+    ASSERT_TRUE(data.Update(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t), 0));
+
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(data.GetData(), data.GetDataLength()));
+    ASSERT_EQ(decoder.GetDomain(), "DOMAIN");
+    ASSERT_EQ(decoder.GetName(), "EVENT_NAME");
+    ASSERT_TRUE(decoder.HasTraceInfo());
+    // fields of the packed struct are read by value, since they may be misaligned for references
+    uint64_t decodedTraceId = decoder.GetTraceInfo().traceId;
+    uint64_t traceId = traceInfo.traceId;
+    ASSERT_EQ(decodedTraceId, traceId);
+    ASSERT_EQ(decoder.GetParamCount(), static_cast<size_t>(paramCnt));
+    DecodedParam param;
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.key, "INT");
+    ASSERT_EQ(param.int64Value, INT64_MIN);
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.uint64Value, UINT64_MAX);
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.stringValue, "a\\nb");
+    ASSERT_TRUE(decoder.NextParam(param));
+    std::vector<std::string_view> decodedStrs;
+    ASSERT_TRUE(RawDataDecoder::ArrayItemsDecoded(param, decodedStrs));
+    ASSERT_EQ(decodedStrs, std::vector<std::string_view>({ "", "abc" }));
+    std::vector<int64_t> mismatchedItems;
+    ASSERT_FALSE(RawDataDecoder::ArrayItemsDecoded(param, mismatchedItems));
+    ASSERT_TRUE(decoder.NextParam(param));
+    std::vector<double> decodedFloats;
+    ASSERT_TRUE(RawDataDecoder::ArrayItemsDecoded(param, decodedFloats));
+    ASSERT_EQ(decodedFloats, std::vector<double>({ 1.5, -2.0 })); // 1.5, -2.0: test values
+    ASSERT_FALSE(decoder.NextParam(param));
+    ASSERT_FALSE(decoder.IsMalformed());
+
+    // the last item of array is truncated
+    blockSize = static_cast<int32_t>(data.GetDataLength() - 1);
+    ASSERT_TRUE(data.Update(reinterpret_cast<uint8_t*>(&blockSize), sizeof(int32_t), 0));
+    ASSERT_TRUE(decoder.Init(data.GetData(), data.GetDataLength()));
+    while (decoder.NextParam(param)) {}
+    ASSERT_TRUE(decoder.IsMalformed());
+    ASSERT_FALSE(decoder.Init(data.GetData(), sizeof(int32_t) + sizeof(struct HiSysEventHeader)));
+}
+
+/**
+ * @tc.name: SocketPathTest001
+ * @tc.desc: Events are sent to the socket whose path is set
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, SocketPathTest001, TestSize.Level1)
+{
+    ASSERT_FALSE(EventSocketFactory::SetSocketPath("", DEFAULT_FAST_SOCKET_PATH));
+    ASSERT_FALSE(EventSocketFactory::SetSocketPath(std::string(sizeof(sockaddr_un::sun_path), 'a'),
+        DEFAULT_FAST_SOCKET_PATH));
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "SOCKET_PATH", HiSysEvent::EventType::BEHAVIOR, "KEY", 1), SUCCESS);
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    ssize_t len = recv(socketId, buffer.data(), buffer.size(), 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_GT(len, 0);
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(buffer.data(), static_cast<size_t>(len)));
+    ASSERT_EQ(decoder.GetName(), "SOCKET_PATH");
+    ASSERT_EQ(HiSysEventWrite(DOMAIN, "SOCKET_PATH", HiSysEvent::EventType::BEHAVIOR, "KEY", 1), SUCCESS);
+}
+
+/**
+ * @tc.name: RouteTest001
+ * @tc.desc: Events are routed by the built-in events with higher priority and the ones loaded from config file
+ * @tc.type: FUNC
+ * @tc.require: issueI8YWH1
+ */
+HWTEST_F(HiSysEventEncodedTest, RouteTest001, TestSize.Level1)
+{
+    ASSERT_TRUE(EventSocketFactory::IsHigherPriorityEvent("AAFWK", "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT));
+    ASSERT_TRUE(EventSocketFactory::IsHigherPriorityEvent("RELIABILITY", "ANY", HiSysEvent::EventType::FAULT));
+    ASSERT_FALSE(EventSocketFactory::IsHigherPriorityEvent("RELIABILITY", "ANY", HiSysEvent::EventType::BEHAVIOR));
+    ASSERT_FALSE(EventSocketFactory::IsHigherPriorityEvent("AAFWK", "APP_INPUT", HiSysEvent::EventType::FAULT));
+    ASSERT_FALSE(EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT));
+    {
+        std::ofstream fout(PRIORITY_CONFIG_PATH);
+        fout << "# domain name [type ...]" << std::endl;
+        fout << DOMAIN << " ROUTE_EVENT" << std::endl;
+        fout << DOMAIN << " * FAULT" << std::endl;
+        fout << DOMAIN << " * SECURITY  # types of the same event are merged" << std::endl;
+    }
+    ASSERT_TRUE(EventSocketFactory::LoadHigherPriorityEvents(PRIORITY_CONFIG_PATH));
+    bool isLoaded = EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ROUTE_EVENT", HiSysEvent::EventType::BEHAVIOR) &&
+        EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ANY", HiSysEvent::EventType::FAULT) &&
+        EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ANY", HiSysEvent::EventType::SECURITY) &&
+        !EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ANY", HiSysEvent::EventType::BEHAVIOR) &&
+        !EventSocketFactory::IsHigherPriorityEvent("AAFWK", "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT);
+    {
+        std::ofstream fout(PRIORITY_CONFIG_PATH);
+        fout << DOMAIN << " ROUTE_EVENT UNKNOWN_TYPE" << std::endl;
+    }
+    bool isInvalidLoaded = EventSocketFactory::LoadHigherPriorityEvents(PRIORITY_CONFIG_PATH);
+    bool isKept = EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ROUTE_EVENT", HiSysEvent::EventType::BEHAVIOR);
+    (void)unlink(PRIORITY_CONFIG_PATH);
+    ASSERT_TRUE(EventSocketFactory::LoadHigherPriorityEvents(""));
+    ASSERT_TRUE(isLoaded);
+    ASSERT_FALSE(isInvalidLoaded);
+    ASSERT_TRUE(isKept);
+    ASSERT_FALSE(EventSocketFactory::LoadHigherPriorityEvents(PRIORITY_CONFIG_PATH));
+    ASSERT_TRUE(EventSocketFactory::IsHigherPriorityEvent("AAFWK", "APP_INPUT_BLOCK", HiSysEvent::EventType::FAULT));
+    auto route = EventSocketFactory::GetEventRoute("AAFWK", "APP_INPUT_BLOCK", HiSysEvent::EventType::BEHAVIOR);
+    ASSERT_EQ(route.socket, &EventSocketFactory::GetEventSocket(true));
+    ASSERT_TRUE(route.isUrgent);
+    route = EventSocketFactory::GetEventRoute(DOMAIN, "ROUTE_EVENT", HiSysEvent::EventType::FAULT);
+    ASSERT_EQ(route.socket, &EventSocketFactory::GetEventSocket(false));
+    ASSERT_TRUE(route.isUrgent); // events of FAULT type are never delayed
+    route = EventSocketFactory::GetEventRoute(DOMAIN, "ROUTE_EVENT", HiSysEvent::EventType::BEHAVIOR);
+    ASSERT_EQ(route.socket, &EventSocketFactory::GetEventSocket(false));
+    ASSERT_FALSE(route.isUrgent);
+}
+
+/**
+ * @tc.name: EventRuleTableTest001
+ * @tc.desc: Rules are found by hashes of domain and name, rules of the event take precedence over the ones of
+ *     all events of the domain, and rules with the same hash are matched in order
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, EventRuleTableTest001, TestSize.Level1)
+{
+    const uint8_t faultMask = EventRuleTable::GetTypeMask(HiSysEvent::EventType::FAULT);
+    const uint8_t behaviorMask = EventRuleTable::GetTypeMask(HiSysEvent::EventType::BEHAVIOR);
+    EventRuleTable table({
+        EventRuleTable::Rule(DOMAIN, "RULE", EventRuleTable::ANY_TYPE_MASK, 1),
+        EventRuleTable::Rule(DOMAIN, EventRuleTable::ANY_EVENT_NAME, faultMask, 2),
+        EventRuleTable::Rule("OTHER", "RULE", behaviorMask, 3),
+    });
+    ASSERT_EQ(table.GetRuleCount(), 3);
+    auto rule = table.Find(DOMAIN, "RULE", HiSysEvent::EventType::FAULT);
+    ASSERT_TRUE(rule != nullptr && rule->value == 1);
+    rule = table.Find(DOMAIN, "ANY", HiSysEvent::EventType::FAULT);
+    ASSERT_TRUE(rule != nullptr && rule->value == 2);
+    ASSERT_EQ(table.Find(DOMAIN, "ANY", HiSysEvent::EventType::BEHAVIOR), nullptr);
+    rule = table.Find("OTHER", "RULE", HiSysEvent::EventType::BEHAVIOR);
+    ASSERT_TRUE(rule != nullptr && rule->value == 3);
+    ASSERT_EQ(table.Find("OTHER", "RULE", HiSysEvent::EventType::FAULT), nullptr);
+    ASSERT_EQ(table.Find("OTHER", "ANY", HiSysEvent::EventType::BEHAVIOR), nullptr);
+    ASSERT_NE(EventRuleTable::GetEventHash(DOMAIN, "RULE"), EventRuleTable::GetEventHash(std::string(DOMAIN) + "RULE", ""));
+
+    // rules of different events with the same hash, which are told apart by the types only
+    const uint64_t collidedHash = EventRuleTable::GetEventHash(DOMAIN, "COLLIDED");
+    EventRuleTable collidedTable({
+        EventRule { collidedHash, faultMask, 1 },
+        EventRule { EventRuleTable::GetEventHash(DOMAIN, "RULE"), EventRuleTable::ANY_TYPE_MASK, 2 },
+        EventRule { collidedHash, EventRuleTable::ANY_TYPE_MASK, 3 },
+    });
+    rule = collidedTable.Find(DOMAIN, "COLLIDED", HiSysEvent::EventType::FAULT);
+    ASSERT_TRUE(rule != nullptr && rule->value == 1);
+    rule = collidedTable.Find(DOMAIN, "COLLIDED", HiSysEvent::EventType::BEHAVIOR);
+    ASSERT_TRUE(rule != nullptr && rule->value == 3);
+    rule = collidedTable.Find(DOMAIN, "RULE", HiSysEvent::EventType::FAULT);
+    ASSERT_TRUE(rule != nullptr && rule->value == 2);
+    constexpr auto collidedRules = EventRuleTable::SortedRules(std::array {
+        EventRuleTable::Rule(DOMAIN, "COLLIDED"), EventRuleTable::Rule(DOMAIN, "RULE"),
+        EventRuleTable::Rule(DOMAIN, "COLLIDED", faultMask),
+    });
+    static_assert(!EventRuleTable::IsCollisionFree(collidedRules), "rules of the same event should collide");
+}
+
+/**
+ * @tc.name: EventRuleTableTest002
+ * @tc.desc: Events with higher priority are found by the writing threads while the table is replaced
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventEncodedTest, EventRuleTableTest002, TestSize.Level1)
+{
+    {
+        std::ofstream fout(PRIORITY_CONFIG_PATH);
+        fout << DOMAIN << " ROUTE_EVENT" << std::endl;
+        fout << "AAFWK APP_INPUT_BLOCK" << std::endl;
+    }
+    const size_t threadCnt = 4;
+    const int replacedCnt = 100;
+    std::atomic<bool> isReplacing { true };
+    std::atomic<size_t> unexpectedCnt { 0 };
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&isReplacing, &unexpectedCnt] {
+            while (isReplacing.load()) {
+                // the event is in both of the tables, and the other one is in neither of them
+                if (!EventSocketFactory::IsHigherPriorityEvent("AAFWK", "APP_INPUT_BLOCK",
+                    HiSysEvent::EventType::FAULT) ||
+                    EventSocketFactory::IsHigherPriorityEvent(DOMAIN, "ANY", HiSysEvent::EventType::BEHAVIOR)) {
+                    unexpectedCnt++;
+                }
+            }
+        });
+    }
+    bool isLoaded = true;
+    for (int i = 0; i < replacedCnt; ++i) {
+        isLoaded = EventSocketFactory::LoadHigherPriorityEvents((i % 2 == 0) ? PRIORITY_CONFIG_PATH : "") &&
+            isLoaded;
+    }
+    isReplacing.store(false);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    (void)unlink(PRIORITY_CONFIG_PATH);
+    ASSERT_TRUE(EventSocketFactory::LoadHigherPriorityEvents(""));
+    ASSERT_TRUE(isLoaded);
+    ASSERT_EQ(unexpectedCnt.load(), 0);
+}
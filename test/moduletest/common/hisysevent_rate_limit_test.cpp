@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "def.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_rate_limit_test_socket";
+constexpr char RATE_LIMIT_CONFIG_PATH[] = "hisysevent_rate_limit_test.cfg";
+}
+
+class HiSysEventRateLimitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventRateLimitTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventRateLimitTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventRateLimitTest::SetUp(void)
+{
+}
+
+void HiSysEventRateLimitTest::TearDown(void)
+{
+    (void)HiSysEvent::SetRateLimit("");
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    (void)unlink(RATE_LIMIT_CONFIG_PATH);
+}
+
+/**
+ * @tc.name: RateLimitTest001
+ * @tc.desc: Events out of the budgets of the call site, the domain or the process loaded from config file are
+ *     discarded, and nothing is limited once the config is unloaded
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventRateLimitTest, RateLimitTest001, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    auto writeEvents = [socketId] (const char* configLine, int writeCnt) {
+        int passedCnt = 0;
+        if (configLine != nullptr) {
+            std::ofstream fout(RATE_LIMIT_CONFIG_PATH);
+            fout << "# SCOPE [DOMAIN] EVENT_RATE EVENT_BURST [BYTE_RATE BYTE_BURST]" << std::endl;
+            fout << configLine << std::endl;
+            fout.close();
+            passedCnt = HiSysEvent::SetRateLimit(RATE_LIMIT_CONFIG_PATH) ? 0 : -1;
+        }
+        std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+        for (int i = 0; i < writeCnt && passedCnt >= 0; ++i) {
+            if (HiSysEventWrite(DOMAIN, "RATE_LIMIT", HiSysEvent::EventType::BEHAVIOR, "KEY", i) == SUCCESS) {
+                // the queue of the socket is drained, so that sending never fails
+                passedCnt += (recv(socketId, buffer.data(), buffer.size(), 0) > 0) ? 1 : 0;
+            }
+        }
+        return passedCnt;
+    };
+    const int writeCnt = 5;
+    RateLimitStats beginStats;
+    HiSysEvent::GetRateLimitStats(beginStats);
+    int callSitePassedCnt = writeEvents("CALL_SITE 1 3", writeCnt);
+    int domainPassedCnt = writeEvents("DOMAIN HIVIEWDFX 1 2 # the budget of the domain", writeCnt);
+    int otherDomainPassedCnt = writeEvents("DOMAIN OTHER_DOMAIN 1 2", writeCnt);
+    int processPassedCnt = writeEvents("PROCESS 0 0 1 1", writeCnt); // 1 byte is less than any event
+    bool isInvalidLoaded = HiSysEvent::SetRateLimit(RATE_LIMIT_CONFIG_PATH) &&
+        writeEvents("DOMAIN * 1 2 3", writeCnt) >= 0;
+    RateLimitStats endStats;
+    HiSysEvent::GetRateLimitStats(endStats);
+    ASSERT_TRUE(HiSysEvent::SetRateLimit(""));
+    int unlimitedPassedCnt = writeEvents(nullptr, writeCnt);
+    RateLimitStats unloadedStats;
+    HiSysEvent::GetRateLimitStats(unloadedStats);
+    (void)unlink(RATE_LIMIT_CONFIG_PATH);
+    ASSERT_TRUE(HiSysEvent::SetRateLimit(""));
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    ASSERT_EQ(callSitePassedCnt, 3); // 3: burst of the call site
+    ASSERT_EQ(domainPassedCnt, 2); // 2: burst of the domain
+    ASSERT_EQ(otherDomainPassedCnt, writeCnt);
+    ASSERT_EQ(processPassedCnt, 0);
+    ASSERT_FALSE(isInvalidLoaded);
+    ASSERT_TRUE(endStats.isEnabled);
+    ASSERT_EQ(endStats.callSiteLimitedCnt - beginStats.callSiteLimitedCnt, writeCnt - 3); // 3: burst of call site
+    ASSERT_EQ(endStats.domainLimitedCnt - beginStats.domainLimitedCnt, writeCnt - 2); // 2: burst of domain
+    ASSERT_EQ(endStats.processLimitedCnt - beginStats.processLimitedCnt, writeCnt);
+    ASSERT_EQ(unlimitedPassedCnt, writeCnt);
+    ASSERT_FALSE(unloadedStats.isEnabled);
+}
+
+/**
+ * @tc.name: RateLimitTest002
+ * @tc.desc: The budget of call sites takes the place of the period and threshold of each call site once it is
+ *     loaded, and the threshold applies again once the budget is unloaded
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventRateLimitTest, RateLimitTest002, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    auto writeEvents = [socketId] (int writeCnt) {
+        int passedCnt = 0;
+        std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+        for (int i = 0; i < writeCnt; ++i) {
+            if (HiSysEventWrite(DOMAIN, "RATE_LIMIT", HiSysEvent::EventType::BEHAVIOR, "KEY", i) == SUCCESS) {
+                passedCnt += (recv(socketId, buffer.data(), buffer.size(), 0) > 0) ? 1 : 0;
+            }
+        }
+        return passedCnt;
+    };
+    const int burst = 200;
+    const int writeCnt = 150; // more than the default threshold and less than the burst
+    {
+        std::ofstream fout(RATE_LIMIT_CONFIG_PATH);
+        fout << "CALL_SITE 1 " << burst << std::endl;
+    }
+    ASSERT_TRUE(HiSysEvent::SetRateLimit(RATE_LIMIT_CONFIG_PATH));
+    int budgetPassedCnt = writeEvents(writeCnt);
+    ASSERT_TRUE(HiSysEvent::SetRateLimit(""));
+    int thresholdPassedCnt = writeEvents(writeCnt);
+    close(socketId);
+    ASSERT_EQ(budgetPassedCnt, writeCnt);
+    ASSERT_EQ(thresholdPassedCnt, HISYSEVENT_DEFAULT_THRESHOLD);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "def.h"
+#include "event_sampler.h"
+#include "event_socket_factory.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+#include "raw_data_base_def.h"
+#include "raw_data_decoder.h"
+#include "securec.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::HiviewDFX::Encoded;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char SAMPLED_DOMAIN[] = "SAMPLED_DOMAIN";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_sampling_test_socket";
+
+std::vector<HiSysEventParam> CreateInt32Params(size_t paramCnt)
+{
+    std::vector<HiSysEventParam> params(paramCnt);
+    for (size_t i = 0; i < paramCnt; ++i) {
+        std::string name = "KEY" + std::to_string(i);
+        (void)strcpy_s(params[i].name, sizeof(params[i].name), name.c_str());
+        params[i].t = HISYSEVENT_INT32;
+        params[i].v.i32 = static_cast<int32_t>(i);
+        params[i].arraySize = 0;
+    }
+    return params;
+}
+}
+
+class HiSysEventSamplingTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventSamplingTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventSamplingTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventSamplingTest::SetUp(void)
+{
+}
+
+void HiSysEventSamplingTest::TearDown(void)
+{
+    (void)HiSysEvent::SetSamplingPolicies({});
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+}
+
+/**
+ * @tc.name: SamplingTest001
+ * @tc.desc: BEHAVIOR events are dropped or kept evenly by the sampling policies before being encoded, and the
+ *     events kept carry the rate of the policy
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventSamplingTest, SamplingTest001, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    SamplingPolicy dropAll { 0, SamplingMode::SAMPLE_RANDOM, { "SAMPLED_DOMAIN *" } };
+    SamplingPolicy keepHalf { FULL_SAMPLING_RATE / 2, SamplingMode::SAMPLE_DETERMINISTIC, { "HIVIEWDFX SAMPLING" } };
+    SamplingPolicy invalidRate { FULL_SAMPLING_RATE + 1, SamplingMode::SAMPLE_RANDOM, { "HIVIEWDFX SAMPLING" } };
+    bool isInvalidSet = HiSysEvent::SetSamplingPolicies({ invalidRate });
+    ASSERT_TRUE(HiSysEvent::SetSamplingPolicies({ dropAll, keepHalf }));
+    const int writeCnt = 4;
+    std::vector<int> rets;
+    int receivedCnt = 0;
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    ssize_t keptLen = 0;
+    for (int i = 0; i < writeCnt; ++i) {
+        rets.push_back(HiSysEventWrite(SAMPLED_DOMAIN, "SAMPLING", HiSysEvent::EventType::BEHAVIOR, "KEY", i));
+        rets.push_back(HiSysEventWrite(DOMAIN, "SAMPLING", HiSysEvent::EventType::BEHAVIOR, "KEY", i));
+        // the queue of the socket is drained, so that sending never fails
+        ssize_t len = recv(socketId, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (len > 0) {
+            keptLen = len;
+            ++receivedCnt;
+        }
+    }
+    SamplingStats dropAllStats;
+    bool isDropAllGot = HiSysEvent::GetSamplingStats(0, dropAllStats);
+    SamplingStats keepHalfStats;
+    bool isKeepHalfGot = HiSysEvent::GetSamplingStats(1, keepHalfStats);
+    ASSERT_TRUE(HiSysEvent::SetSamplingPolicies({}));
+    SamplingStats disabledStats;
+    bool isDisabledGot = HiSysEvent::GetSamplingStats(0, disabledStats);
+    close(socketId);
+    ASSERT_FALSE(isInvalidSet);
+    ASSERT_EQ(rets, std::vector<int>(writeCnt * 2, SUCCESS)); // 2: events of both policies
+    ASSERT_EQ(receivedCnt, writeCnt / 2); // 2: half of the events are kept
+    ASSERT_TRUE(isDropAllGot);
+    ASSERT_EQ(dropAllStats.keptCnt, 0);
+    ASSERT_EQ(dropAllStats.droppedCnt, writeCnt);
+    ASSERT_TRUE(isKeepHalfGot);
+    ASSERT_EQ(keepHalfStats.keptCnt, writeCnt / 2); // 2: half of the events are kept
+    ASSERT_EQ(keepHalfStats.droppedCnt, writeCnt / 2); // 2: half of the events are dropped
+    ASSERT_FALSE(isDisabledGot);
+
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(buffer.data(), static_cast<size_t>(keptLen)));
+    ASSERT_EQ(decoder.GetName(), "SAMPLING");
+    DecodedParam param;
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.key, "KEY");
+    ASSERT_TRUE(decoder.NextParam(param));
+    ASSERT_EQ(param.key, EventSampler::SAMPLING_RATE_KEY);
+    ASSERT_DOUBLE_EQ(param.floatingValue, 0.5); // 0.5: rate of the policy
+}
+
+/**
+ * @tc.name: SamplingTest002
+ * @tc.desc: Events kept by the sampling policies are discarded with ERR_KEY_NUMBER_TOO_MUCH instead of being sent
+ *     without the rate if they already have MAX_PARAM_NUMBER parameters
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventSamplingTest, SamplingTest002, TestSize.Level1)
+{
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    ASSERT_GE(socketId, 0);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    SamplingPolicy keepHalf { FULL_SAMPLING_RATE / 2, SamplingMode::SAMPLE_DETERMINISTIC, { "HIVIEWDFX SAMPLING" } };
+    ASSERT_TRUE(HiSysEvent::SetSamplingPolicies({ keepHalf }));
+    const int writeCnt = 2;
+    std::vector<HiSysEventParam> fullParams = CreateInt32Params(MAX_PARAM_NUMBER);
+    std::vector<int> fullRets;
+    std::vector<uint8_t> buffer(MAX_DATA_SIZE);
+    int fullReceivedCnt = 0;
+    for (int i = 0; i < writeCnt; ++i) {
+        fullRets.push_back(HiSysEvent_Write(__FUNCTION__, __LINE__, DOMAIN, "SAMPLING", HISYSEVENT_BEHAVIOR,
+            fullParams.data(), fullParams.size()));
+        if (recv(socketId, buffer.data(), buffer.size(), MSG_DONTWAIT) > 0) {
+            ++fullReceivedCnt;
+        }
+    }
+    std::vector<HiSysEventParam> params = CreateInt32Params(MAX_PARAM_NUMBER - 1);
+    std::vector<int> rets;
+    int receivedCnt = 0;
+    ssize_t keptLen = 0;
+    for (int i = 0; i < writeCnt; ++i) {
+        rets.push_back(HiSysEvent_Write(__FUNCTION__, __LINE__, DOMAIN, "SAMPLING", HISYSEVENT_BEHAVIOR,
+            params.data(), params.size()));
+        ssize_t len = recv(socketId, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (len > 0) {
+            keptLen = len;
+            ++receivedCnt;
+        }
+    }
+    close(socketId);
+    std::sort(fullRets.begin(), fullRets.end());
+    ASSERT_EQ(fullRets, std::vector<int>({ SUCCESS, ERR_KEY_NUMBER_TOO_MUCH }));
+    ASSERT_EQ(fullReceivedCnt, 0);
+    ASSERT_EQ(rets, std::vector<int>(writeCnt, SUCCESS));
+    ASSERT_EQ(receivedCnt, writeCnt / 2); // 2: half of the events are kept
+
+    RawDataDecoder decoder;
+    ASSERT_TRUE(decoder.Init(buffer.data(), static_cast<size_t>(keptLen)));
+    ASSERT_EQ(decoder.GetParamCount(), MAX_PARAM_NUMBER);
+    DecodedParam param;
+    for (size_t i = 0; i < MAX_PARAM_NUMBER; ++i) {
+        ASSERT_TRUE(decoder.NextParam(param));
+    }
+    ASSERT_EQ(param.key, EventSampler::SAMPLING_RATE_KEY);
+    ASSERT_DOUBLE_EQ(param.floatingValue, 0.5); // 0.5: rate of the policy
+}
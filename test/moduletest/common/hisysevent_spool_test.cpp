@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest-message.h"
+#include "gtest/gtest-test-part.h"
+#include "gtest/hwext/gtest-ext.h"
+#include "gtest/hwext/gtest-tag.h"
+
+#include "def.h"
+#include "event_socket_factory.h"
+#include "event_spool.h"
+#include "hisysevent.h"
+#include "hisysevent_local_socket.h"
+
+using namespace testing::ext;
+using namespace OHOS::HiviewDFX;
+
+namespace {
+constexpr char DOMAIN[] = "HIVIEWDFX";
+constexpr char LOCAL_SOCKET_PATH[] = "hisysevent_spool_test_socket";
+constexpr char SPOOL_PATH[] = "hisysevent_spool_test.spool";
+}
+
+class HiSysEventSpoolTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+    static void TearDownTestCase(void);
+    void SetUp();
+    void TearDown();
+};
+
+void HiSysEventSpoolTest::SetUpTestCase(void)
+{
+}
+
+void HiSysEventSpoolTest::TearDownTestCase(void)
+{
+}
+
+void HiSysEventSpoolTest::SetUp(void)
+{
+}
+
+void HiSysEventSpoolTest::TearDown(void)
+{
+    (void)HiSysEvent::SetEventSpool(false);
+    (void)EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH);
+    HiSysEvent::SetCircuitBreaker(true);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    (void)unlink(SPOOL_PATH);
+}
+
+/**
+ * @tc.name: EventSpoolTest001
+ * @tc.desc: Fault events failed to send are kept in the spool file, left to the next opening unless they are torn,
+ *     and sent in background once hiview is available
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventSpoolTest, EventSpoolTest001, TestSize.Level1)
+{
+    (void)unlink(SPOOL_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    HiSysEvent::SetCircuitBreaker(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    bool isOpened = HiSysEvent::SetEventSpool(true, SPOOL_PATH, MIN_SPOOL_CAPACITY);
+    const int spooledCnt = 3;
+    for (int i = 0; i < spooledCnt; ++i) {
+        (void)HiSysEventWrite(DOMAIN, "SPOOL", HiSysEvent::EventType::FAULT, "KEY", i);
+    }
+    EventSpoolStats spooledStats;
+    HiSysEvent::GetEventSpoolStats(spooledStats);
+    (void)HiSysEvent::SetEventSpool(false);
+
+    // tear the last record, which is followed by padding of 8 bytes at most
+    const size_t tornOffset = EventSpool::FILE_HEADER_SIZE + spooledStats.usedBytes - 8;
+    std::fstream spoolFile(SPOOL_PATH, std::ios::in | std::ios::out | std::ios::binary);
+    spoolFile.seekg(tornOffset);
+    char tornByte = static_cast<char>(spoolFile.get() ^ 0xFF);
+    spoolFile.seekp(tornOffset);
+    spoolFile.put(tornByte);
+    spoolFile.close();
+
+    int socketId = BindLocalSocket(LOCAL_SOCKET_PATH);
+    bool isReopened = HiSysEvent::SetEventSpool(true, SPOOL_PATH, MIN_SPOOL_CAPACITY);
+    EventSpoolStats recoveredStats;
+    HiSysEvent::GetEventSpoolStats(recoveredStats);
+    const int maxWaitCnt = 3000; // 3s, the retry thread may be waiting for the next round
+    EventSpoolStats drainedStats;
+    std::vector<char> buf(MAX_DATA_SIZE);
+    for (int i = 0; i < maxWaitCnt; ++i) {
+        HiSysEvent::GetEventSpoolStats(drainedStats);
+        if (drainedStats.pendingCnt == 0) {
+            break;
+        }
+        // events left to retry are sent as well, which should not fill up the socket
+        while (recv(socketId, buf.data(), buf.size(), MSG_DONTWAIT) > 0) {}
+        usleep(1000); // 1ms
+    }
+    (void)HiSysEvent::SetEventSpool(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(DEFAULT_SOCKET_PATH, DEFAULT_FAST_SOCKET_PATH));
+    HiSysEvent::SetCircuitBreaker(true);
+    close(socketId);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    (void)unlink(SPOOL_PATH);
+    ASSERT_TRUE(isOpened);
+    ASSERT_EQ(spooledStats.spooledCnt, spooledCnt);
+    ASSERT_EQ(spooledStats.pendingCnt, spooledCnt);
+    ASSERT_TRUE(isReopened);
+    ASSERT_EQ(recoveredStats.recoveredCnt, spooledCnt - 1);
+    ASSERT_EQ(recoveredStats.tornCnt, 1);
+    ASSERT_EQ(drainedStats.pendingCnt, 0);
+    ASSERT_EQ(drainedStats.drainedCnt, spooledCnt - 1);
+}
+
+/**
+ * @tc.name: EventSpoolTest002
+ * @tc.desc: Only fault events failed to send are kept in the spool file, the others are left to the retry queue
+ * @tc.type: FUNC
+ */
+HWTEST_F(HiSysEventSpoolTest, EventSpoolTest002, TestSize.Level1)
+{
+    (void)unlink(SPOOL_PATH);
+    (void)unlink(LOCAL_SOCKET_PATH);
+    HiSysEvent::SetCircuitBreaker(false);
+    ASSERT_TRUE(EventSocketFactory::SetSocketPath(LOCAL_SOCKET_PATH, LOCAL_SOCKET_PATH));
+    ASSERT_TRUE(HiSysEvent::SetEventSpool(true, SPOOL_PATH, MIN_SPOOL_CAPACITY));
+    EventSpoolStats base;
+    HiSysEvent::GetEventSpoolStats(base);
+    int behaviorRet = HiSysEventWrite(DOMAIN, "SPOOL", HiSysEvent::EventType::BEHAVIOR, "KEY", 1);
+    EventSpoolStats behaviorStats;
+    HiSysEvent::GetEventSpoolStats(behaviorStats);
+    int faultRet = HiSysEventWrite(DOMAIN, "SPOOL", HiSysEvent::EventType::FAULT, "KEY", 1);
+    EventSpoolStats faultStats;
+    HiSysEvent::GetEventSpoolStats(faultStats);
+    ASSERT_TRUE(base.isOpened);
+    ASSERT_EQ(base.capacity, MIN_SPOOL_CAPACITY);
+    ASSERT_EQ(behaviorRet, ERR_SEND_FAIL);
+    ASSERT_EQ(behaviorStats.spooledCnt, base.spooledCnt);
+    ASSERT_EQ(faultRet, ERR_SEND_FAIL);
+    ASSERT_EQ(faultStats.spooledCnt, base.spooledCnt + 1);
+}
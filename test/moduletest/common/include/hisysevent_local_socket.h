@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISYSEVENT_LOCAL_SOCKET_H
+#define HISYSEVENT_LOCAL_SOCKET_H
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "securec.h"
+
+constexpr char DEFAULT_SOCKET_PATH[] = "/dev/unix/socket/hisysevent";
+constexpr char DEFAULT_FAST_SOCKET_PATH[] = "/dev/unix/socket/hisysevent_fast";
+
+// datagram socket which stands in for the one listened by hiview
+inline int BindLocalSocket(const char* path)
+{
+    int socketId = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un addr = { .sun_family = AF_UNIX, .sun_path = { 0 } };
+    struct timeval timeout = { .tv_sec = 1, .tv_usec = 0 };
+    (void)unlink(path);
+    if (socketId < 0 || strcpy_s(addr.sun_path, sizeof(addr.sun_path), path) != EOK ||
+        bind(socketId, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        setsockopt(socketId, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+        close(socketId);
+        return -1;
+    }
+    return socketId;
+}
+
+#endif // HISYSEVENT_LOCAL_SOCKET_H